@@ -0,0 +1,18 @@
+#pragma pack_matrix(row_major)
+
+cbuffer BlockCamera : register(b0) {
+	matrix viewProjection; // ビュー変換行列 × プロジェクション変換行列
+};
+
+// ブロック1つ分のインスタンスデータ（C++ の BlockInstance と同じ並び）
+struct BlockInstance {
+	float3 position; // ブロックの中心（ワールド座標）
+	float padding;
+};
+
+// 頂点シェーダーからピクセルシェーダーへのやり取りに使用する構造体
+struct VSOutput {
+	float4 svpos : SV_POSITION; // システム用頂点座標
+	float3 normal : NORMAL;     // 法線
+	float2 uv : TEXCOORD;       // uv値
+};
@@ -0,0 +1,16 @@
+#include "Block.hlsli"
+
+StructuredBuffer<BlockInstance> instances : register(t1); // 見えているブロックの位置
+
+VSOutput main(float3 pos : POSITION, float3 normal : NORMAL, float2 uv : TEXCOORD, uint instanceId : SV_InstanceID) {
+	// ブロックは回転・拡大しないので、中心の位置を足すだけでワールド座標になる
+	float4 worldPos = float4(pos + instances[instanceId].position, 1);
+
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(worldPos, viewProjection);
+
+	output.normal = normal;
+	output.uv = uv;
+
+	return output;
+}
\ No newline at end of file
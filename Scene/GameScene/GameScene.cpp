@@ -1,53 +1,26 @@
 #include "GameScene.h"
 #include "struct.h"
 #include "CommonBGM/CommonBGM.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+// 範囲（XY）を Z 方向に無限の箱にする（EntityWorld のシステムに渡す用）
+static AABB RectToAABB(const Rect& rect) {
+	const float inf = std::numeric_limits<float>::infinity();
+	return {
+	    {rect.left, rect.bottom, -inf},
+	    {rect.right, rect.top, inf}
+    };
+}
 
 GameScene::~GameScene() {
-	// スプライトの解放
-	delete model_;
-	delete skydome_;
-	delete skydomeModel_;
-	delete player_;
-	delete playerModel_;
-	delete mapChipField_;
-	delete cameraController_;
-	delete enemyModel_;
-	model_ = nullptr;
-
-	for (Enemy* enemy : enemies_) {
-		delete enemy;
-	}
-
-	for (std::vector<WorldTransform*>& worldTransformLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformLine) {
-			delete worldTransformBlock;
-		}
-	}
-
-	for (Coin* coin : coins_) {
-		delete coin;
-	}
-	coins_.clear();
-	delete coinModel_;
-	coinModel_ = nullptr;
 
-	for (Goal* goal : goals_) {
-		delete goal;
-	}
-	goals_.clear();
-	delete goalModel_;
-	goalModel_ = nullptr;
+	// 敵はボディを KinematicBodySystem に返すので、先に破棄する
+	enemies_.Clear();
 
-	delete pauseFade_;
-	pauseFade_ = nullptr;
-
-	delete starModel_;
-	starModel_ = nullptr;
-
-	delete NoStarModel_;
-	NoStarModel_ = nullptr;
-
-	worldTransformBlocks_.clear();
+	// シーンで作ったものを、作った逆順にまとめて破棄する
+	arena_.Release();
 }
 
 void GameScene::Initialize() {
@@ -69,11 +42,21 @@ void GameScene::Initialize() {
 	// マップチップフィールドの初期化
 	// =============================
 
-	mapChipField_ = new MapChipField();
+	mapChipField_ = arena_.Create<MapChipField>();
 	// マップ読み込み後
-	mapChipField_->LoadMapChipCSV(stageCSVPath_);
+	const auto loadBegin = std::chrono::steady_clock::now();
+	const bool stageLoaded = mapChipField_->LoadStage(stageCSVPath_);
+	stageLoadMilliseconds_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadBegin).count();
+	assert(stageLoaded && "Failed to load stage. See output window for row/column.");
+	(void)stageLoaded;
 	mapChipField_->GenerateBlocks();
 
+	// プレイヤー・敵のマップとの当たり判定をまとめて解く
+	kinematicBodies_.SetMapChipField(mapChipField_);
+
+	// キャラクター・アイテム同士の広域判定はタイル1枚分のセルで区切る
+	collisionHash_.SetCellSize(MapChipField::GetBlockWidth());
+
 	// ▼ Player
 	MapChipField::IndexSet pIndex = {6, 12}; // フォールバック（CSVにpが無い場合）
 	if (auto p = mapChipField_->GetPlayerSpawnIndex()) {
@@ -85,8 +68,8 @@ void GameScene::Initialize() {
 	// 天球の初期化
 	// =============================
 
-	skydome_ = new Skydome();
-	skydomeModel_ = Model::CreateFromOBJ("skydome", true);
+	skydome_ = arena_.Create<Skydome>();
+	skydomeModel_ = arena_.Adopt(Model::CreateFromOBJ("skydome", true));
 	skydome_->SetModel(skydomeModel_);
 	skydome_->Initialize();
 
@@ -97,7 +80,7 @@ void GameScene::Initialize() {
 	// テクスチャの読み込み
 	textureHandle_ = TextureManager::Load("stone_bricks.png");
 
-	model_ = Model::Create();
+	blockRenderer_.Initialize(textureHandle_);
 
 	// ワールドトランスフォームの初期化
 	worldTransform_.Initialize();
@@ -105,24 +88,26 @@ void GameScene::Initialize() {
 	// ==============================
 	// ゴールの初期化
 	// ==============================
-	goalModel_ = Model::CreateFromOBJ("goal", true);
+	goalModel_ = arena_.Adopt(Model::CreateFromOBJ("goal", true));
 
 	// ▼ Goals（CSVの g をすべて生成）
+	props_.Reserve(mapChipField_->GetGoalSpawnIndices().size() + mapChipField_->GetCoinSpawnIndices().size());
 	for (const auto& idx : mapChipField_->GetGoalSpawnIndices()) {
-		Vector3 pos = mapChipField_->GetMapChipPositionByIndex(idx.xIndex, idx.yIndex);
-		Goal* g = new Goal();
-		g->Initialize(&camera_, pos);
-		g->SetModel(goalModel_);
-		g->SetDeltaTime(deltaTime_);
-		goals_.push_back(g);
+		EntityWorld::Desc goal;
+		goal.position = mapChipField_->GetMapChipPositionByIndex(idx.xIndex, idx.yIndex);
+		// ブロック中央返却前提の座標系なので、控えめな半径で当たりを取る
+		goal.halfExtent = {0.45f, 0.45f, 0.45f};
+		goal.rotateSpeed = kGoalRotateSpeed;
+		goal.flags = kEntityGoal | kEntityAnimated | kEntityDrawable;
+		props_.Create(goal);
 	}
 
 	// =============================
 	// 星の初期化
 	// =============================
 
-	starModel_ = Model::CreateFromOBJ("star", true);
-	NoStarModel_ = Model::CreateFromOBJ("nostar", true);
+	starModel_ = arena_.Adopt(Model::CreateFromOBJ("star", true));
+	NoStarModel_ = arena_.Adopt(Model::CreateFromOBJ("nostar", true));
 
 	// =============================
 	// カメラの初期化
@@ -137,61 +122,64 @@ void GameScene::Initialize() {
 	// プレイヤーの初期化
 	// ==============================
 
-	player_ = new Player();
-	playerModel_ = Model::CreateFromOBJ("player", true);
+	player_ = arena_.Create<Player>();
+	playerModel_ = arena_.Adopt(Model::CreateFromOBJ("player", true));
 	player_->SetModel(playerModel_);
 	player_->Initialize(&camera_, playerPosition);
-	player_->SetMapChipField(mapChipField_);
+	player_->SetKinematicBodySystem(&kinematicBodies_);
 	player_->SetDeltaTime(deltaTime_);
 
 	// ==============================
 	// パーティクルの初期化
 	// ==============================
 
-	deathParticles_ = new DeathParticles();
+	deathParticles_ = arena_.Create<DeathParticles>();
 	deathParticles_->Initialize(&camera_, playerPosition);
 	deathParticles_->SetDeltaTime(deltaTime_);
-	deathParticlesModel_ = Model::CreateFromOBJ("deathparticles", true);
+	deathParticlesModel_ = arena_.Adopt(Model::CreateFromOBJ("deathparticles", true));
 	deathParticles_->SetModel(deathParticlesModel_);
 
 	// ==============================
 	// 敵の初期化
 	// ==============================
 
-	enemyModel_ = Model::CreateFromOBJ("enemy", true);
+	enemyModel_ = arena_.Adopt(Model::CreateFromOBJ("enemy", true));
+
+	// 全員で共有するもの
+	enemyPrototype_.model = enemyModel_;
+	enemyPrototype_.camera = &camera_;
+	enemyPrototype_.mapChipField = mapChipField_;
+	enemyPrototype_.kinematicBodies = &kinematicBodies_;
+	enemyPrototype_.deltaTime = deltaTime_;
+	enemyPrototype_.freefall = false; // 落下しないように設定
 
 	// ▼ Enemies（CSVの e をすべて生成）
+	const auto spawnBegin = std::chrono::steady_clock::now();
+	enemies_.Reserve(static_cast<uint32_t>(mapChipField_->GetEnemySpawnIndices().size()) + kSpawnSpareCapacity);
 	for (const auto& idx : mapChipField_->GetEnemySpawnIndices()) {
-		Vector3 pos = mapChipField_->GetMapChipPositionByIndex(idx.xIndex, idx.yIndex);
-		Enemy* e = new Enemy();
-		e->Initialize(&camera_, pos);
-		e->SetModel(enemyModel_);
-		e->SetDeltaTime(deltaTime_);
-		e->SetMapChipField(mapChipField_);
-		e->SetFreefall(false); // 落下しないように設定
-		enemies_.push_back(e);
+		SpawnEnemy(mapChipField_->GetMapChipPositionByIndex(idx.xIndex, idx.yIndex));
 	}
+	enemySpawnMicroseconds_ = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - spawnBegin).count();
 
 	// ==============================
 	// コインの初期化
 	// ==============================
-	coinModel_ = Model::CreateFromOBJ("coin", true);
+	coinModel_ = arena_.Adopt(Model::CreateFromOBJ("coin", true));
 	for (const auto& idx : mapChipField_->GetCoinSpawnIndices()) {
-		Vector3 pos = mapChipField_->GetMapChipPositionByIndex(idx.xIndex, idx.yIndex);
-		Coin* c = new Coin();
-		c->Initialize(&camera_, pos);
-		c->SetModel(coinModel_);
-		c->SetDeltaTime(deltaTime_);
-		coins_.push_back(c);
-		totalCoins_ = static_cast<int>(mapChipField_->GetCoinSpawnIndices().size());
+		EntityWorld::Desc coin;
+		coin.position = mapChipField_->GetMapChipPositionByIndex(idx.xIndex, idx.yIndex);
+		coin.halfExtent = {0.5f, 0.5f, 0.5f}; // 小さめに 0.5f
+		coin.rotateSpeed = kCoinRotateSpeed;
+		coin.flags = kEntityCoin | kEntityAnimated | kEntityDrawable;
+		props_.Create(coin);
 	}
+	totalCoins_ = static_cast<int>(mapChipField_->GetCoinSpawnIndices().size());
 
 	// ============================
 	// カメラコントローラーの初期化
 	// ============================
-	cameraController_ = new CameraController();
+	cameraController_ = arena_.Create<CameraController>();
 	cameraController_->SetCamera(&camera_);
-	cameraController_->Initialize();
 	cameraController_->SetTarget(player_);
 	cameraController_->Reset();
 
@@ -203,9 +191,9 @@ void GameScene::Initialize() {
 
 	// マップの端座標
 	float mapLeft = 0.0f;
-	float mapRight = MapChipField::GetBlockWidth() * MapChipField::GetNumBlockHorizontal();
+	float mapRight = MapChipField::GetBlockWidth() * mapChipField_->GetNumBlockHorizontal();
 	float mapBottom = 0.0f;
-	float mapTop = MapChipField::GetBlockHeight() * MapChipField::GetNumBlockVirtical();
+	float mapTop = MapChipField::GetBlockHeight() * mapChipField_->GetNumBlockVirtical();
 
 	// movableAreaをカメラの視野分だけ内側にオフセット
 	Rect movableArea;
@@ -217,6 +205,17 @@ void GameScene::Initialize() {
 	cameraController_->SetMovableArea(movableArea);
 	cameraController_->Reset();
 
+	// アクティブ範囲は視野に余白を足した大きさ
+	cameraMovableArea_ = movableArea;
+	activeHalfWidth_ = cameraWidth / 2.0f + kActiveRegionMargin;
+	activeHalfHeight_ = cameraHeight / 2.0f + kActiveRegionMargin;
+	UpdateActiveRegion();
+	viewHalfWidth_ = cameraWidth / 2.0f;
+	viewHalfHeight_ = cameraHeight / 2.0f;
+
+	// 開始位置の周りのブロックは読み込みを待たずに用意しておく
+	mapChipField_->PrimeStreaming(camera_.translation_.x);
+
 	// ▼ プレイ範囲（カメラの可動域より一回り広い“実マップ範囲”）
 	playArea_.left = mapLeft;
 	playArea_.right = mapRight;
@@ -230,12 +229,12 @@ void GameScene::Initialize() {
 	// ============================
 
 	// pause用フェードを作成
-	pauseFade_ = new Fade();
+	pauseFade_ = arena_.Create<Fade>();
 	pauseFade_->Initialize();
 
 	phase_ = Phase::kFadeIn;
 
-	fade_ = new Fade();
+	fade_ = arena_.Create<Fade>();
 	fade_->Initialize();
 	fade_->Start(Fade::Status::FadeIn, 2.0f);
 
@@ -245,6 +244,17 @@ void GameScene::Initialize() {
 
 void GameScene::Update() {
 
+	// 作り直した行列の数はフレームごとに数える
+	TransformCache::ResetFrameStats();
+
+	// このフレームで行列を作り、描画に出す範囲
+	UpdateVisibleRegion();
+
+	// フェードとカメラの追従は表示に合わせて実時間で進める
+	fade_->SetDeltaTime(frameDeltaTime_);
+	pauseFade_->SetDeltaTime(frameDeltaTime_);
+	cameraController_->SetDeltaTime(frameDeltaTime_);
+
 	switch (phase_) {
 
 	case Phase::kFadeIn:
@@ -289,6 +299,9 @@ void GameScene::Update() {
 			isFinished_ = true;
 		}
 	}
+
+	// このフレームで巡回から外したものをまとめて破棄する（フレーム中に集めたポインタはここまで有効）
+	enemies_.FlushDespawned();
 }
 
 // =================================
@@ -359,30 +372,148 @@ bool GameScene::IsOutOfPlayableArea(const Vector3& p) const {
 	return belowAbyss || outLeft || outRight;
 }
 
+// =================================
+// 敵の生成
+// =================================
+
+Enemy* GameScene::SpawnEnemy(const Vector3& position) {
+	Enemy* enemy = enemies_.Get(enemies_.Spawn());
+	if (enemy) {
+		enemy->Initialize(enemyPrototype_, position);
+	}
+	return enemy;
+}
+
+// =================================
+// アクティブ範囲
+// =================================
+
+void GameScene::UpdateActiveRegion() {
+	// カメラの目標位置と同じ求め方で中心を決める
+	// 補間後の表示位置や実時間は使わないので、敵が起きるステップは表示のフレームレートに左右されない
+	Vector3 center = player_->GetPosition() + cameraController_->GetTargetOffset();
+	center.x = std::clamp(center.x, cameraMovableArea_.left, cameraMovableArea_.right);
+	center.y = std::clamp(center.y, cameraMovableArea_.bottom, cameraMovableArea_.top);
+
+	activeRegion_.left = center.x - activeHalfWidth_;
+	activeRegion_.right = center.x + activeHalfWidth_;
+	activeRegion_.bottom = center.y - activeHalfHeight_;
+	activeRegion_.top = center.y + activeHalfHeight_;
+}
+
+bool GameScene::IsInActiveRegion(const AABB& aabb) const {
+	return aabb.max.x >= activeRegion_.left && aabb.min.x <= activeRegion_.right && aabb.max.y >= activeRegion_.bottom && aabb.min.y <= activeRegion_.top;
+}
+
+// =================================
+// 可視範囲
+// =================================
+
+void GameScene::UpdateVisibleRegion() {
+
+	// デバッグカメラはどこでも向けられるので、マップ全体を見えているものとする
+	if (isDebugCameraActive_) {
+		visibleRegion_.left = playArea_.left - kVisibleRegionMargin;
+		visibleRegion_.right = playArea_.right + kVisibleRegionMargin;
+		visibleRegion_.bottom = playArea_.bottom - kVisibleRegionMargin;
+		visibleRegion_.top = playArea_.top + kVisibleRegionMargin;
+		return;
+	}
+
+	// カメラは回転せず z = 0 の平面を正面から見ているので、映るのはカメラの XY を中心にした矩形
+	visibleRegion_.left = camera_.translation_.x - viewHalfWidth_ - kVisibleRegionMargin;
+	visibleRegion_.right = camera_.translation_.x + viewHalfWidth_ + kVisibleRegionMargin;
+	visibleRegion_.bottom = camera_.translation_.y - viewHalfHeight_ - kVisibleRegionMargin;
+	visibleRegion_.top = camera_.translation_.y + viewHalfHeight_ + kVisibleRegionMargin;
+}
+
+bool GameScene::IsInVisibleRegion(const AABB& aabb) const {
+	return aabb.max.x >= visibleRegion_.left && aabb.min.x <= visibleRegion_.right && aabb.max.y >= visibleRegion_.bottom && aabb.min.y <= visibleRegion_.top;
+}
+
+// =================================
+// 敵の更新（固定ステップ1回分）
+// =================================
+
+void GameScene::StepEnemies() {
+
+	// 動かす敵を先に決めておく（移動の前後で同じ敵に対して処理する）
+	activeEnemies_.clear();
+	for (Enemy& enemy : enemies_) {
+		if (!enemy.IsDead() && IsInActiveRegion(enemy.GetAABB())) {
+			activeEnemies_.push_back(&enemy);
+		}
+	}
+
+	const uint32_t enemyCount = static_cast<uint32_t>(activeEnemies_.size());
+	const auto forEachEnemy = [&](auto&& func) {
+		if (parallelEnemyUpdate_) {
+			jobSystem_.ParallelFor(enemyCount, kEnemyGrainSize, [&](uint32_t i) { func(activeEnemies_[i]); });
+		} else {
+			for (Enemy* enemy : activeEnemies_) {
+				func(enemy);
+			}
+		}
+	};
+
+	// 移動量を出す → マップとの当たり判定をまとめて解く → 結果を反映する
+	// どの段も敵ごとに独立しているので、段と段の間だけ全員の完了を待てばよい
+	forEachEnemy([](Enemy* enemy) { enemy->Update(); });
+
+	kinematicBodies_.SetJobSystem(parallelEnemyUpdate_ ? &jobSystem_ : nullptr);
+	kinematicBodies_.ResolveMapCollisions();
+
+	forEachEnemy([](Enemy* enemy) { enemy->UpdateAfterMapCollision(); });
+
+	activeEnemies_.clear();
+}
+
 // =================================
 // 全ての当たり判定をチェックする関数
 // =================================
 
 void GameScene::CheckAllCollisions() {
 
-#pragma region プレイヤーと敵キャラの当たり判定
-
-	for (Enemy* enemy : enemies_) {
-		if (enemy && !enemy->IsDead()) {
-			CheckPlayerEnemyCollisions(player_, enemy);
+#pragma region 当たり判定の箱を種類ごとに集める
+
+	// GetAABB はステップごとに1回だけ呼び、箱は成分ごとの配列に詰める
+	enemyBoxes_.Clear();
+	coinBoxes_.Clear();
+	goalBoxes_.Clear();
+	collisionHash_.Clear();
+	collisionEnemies_.clear();
+	collisionCoins_.clear();
+	collisionGoals_.clear();
+	collisionEvents_.Clear();
+
+	for (Enemy& enemy : enemies_) {
+		if (!enemy.IsDead() && IsInActiveRegion(enemy.GetAABB())) {
+			const AABB aabb = enemy.GetAABB();
+			enemyBoxes_.Add(aabb);
+			collisionHash_.Insert(aabb, kCollisionEnemy, kCollisionEnemy, static_cast<uint32_t>(collisionEnemies_.size()));
+			collisionEnemies_.push_back(&enemy);
 		}
 	}
 
+	props_.CollectAABBs(kEntityCoin, kEntityCollected, RectToAABB(activeRegion_), coinBoxes_, collisionCoins_);
+	props_.CollectAABBs(kEntityGoal, kEntityReached, RectToAABB(activeRegion_), goalBoxes_, collisionGoals_);
+
+	const AABB aabbPlayer = player_->GetAABB();
+
+#pragma endregion
+
+#pragma region プレイヤーと敵キャラの当たり判定
+
+	enemyBoxes_.Overlap(aabbPlayer, collisionHits_);
+	AABBBatch::ForEachHit(collisionHits_, [&](uint32_t index) { collisionEvents_.Push(CollisionEvent::Type::kPlayer, 0, CollisionEvent::Type::kEnemy, index); });
+
 #pragma endregion
 
 #pragma region プレイヤーとアイテムの当たり判定
 
 	// プレイヤーとコインの当たり判定
-	for (Coin* coin : coins_) {
-		if (coin && !coin->IsCollected()) {
-			CheckPlayerCoinCollisions(player_, coin);
-		}
-	}
+	coinBoxes_.Overlap(aabbPlayer, collisionHits_);
+	AABBBatch::ForEachHit(collisionHits_, [&](uint32_t index) { collisionEvents_.Push(CollisionEvent::Type::kPlayer, 0, CollisionEvent::Type::kCoin, index); });
 
 #pragma endregion
 
@@ -391,47 +522,66 @@ void GameScene::CheckAllCollisions() {
 #pragma endregion
 
 #pragma region 敵同士の当たり判定
-	// Enemy-Enemy collisions (pairwise)
-	for (auto it1 = enemies_.begin(); it1 != enemies_.end(); ++it1) {
-		auto it2 = it1;
-		++it2;
-		for (; it2 != enemies_.end(); ++it2) {
-			Enemy* a = *it1;
-			Enemy* b = *it2;
-			if (a && b) {
-				a->OnEnemyCollision(b);
-			}
-		}
+
+	// 同じセルに入った組だけを、登録順（リストの順）に調べる
+	collisionHash_.Build();
+	collisionHash_.FindPairs(collisionPairs_);
+	for (const SpatialHash::Pair& pair : collisionPairs_) {
+		collisionEvents_.Push(CollisionEvent::Type::kEnemy, collisionHash_.GetUserData(pair.a), CollisionEvent::Type::kEnemy, collisionHash_.GetUserData(pair.b));
 	}
 
 #pragma endregion
 
 #pragma region プレイヤーとゴールの当たり判定
-	for (Goal* goal : goals_) {
-		if (goal && !goal->IsReached()) {
-			CheckPlayerGoalCollisions(player_, goal);
-		}
-	}
+
+	goalBoxes_.Overlap(aabbPlayer, collisionHits_);
+	AABBBatch::ForEachHit(collisionHits_, [&](uint32_t index) { collisionEvents_.Push(CollisionEvent::Type::kPlayer, 0, CollisionEvent::Type::kGoal, index); });
+
 #pragma endregion
 }
 
 // =================================
-// プレイヤーと敵キャラの当たり判定をチェックする関数
+// 当たった組を積んだ順に処理する関数
 // =================================
 
-void GameScene::CheckPlayerEnemyCollisions(Player* player, Enemy* enemy) {
+void GameScene::HandleCollisionEvents() {
+
+	using Type = CollisionEvent::Type;
+
+	for (const CollisionEvent& event : collisionEvents_.GetEvents()) {
+
+		if (event.typeA == Type::kPlayer) {
+			switch (event.typeB) {
+			case Type::kEnemy:
+				OnPlayerEnemyCollision(collisionEnemies_[event.idB]);
+				break;
+			case Type::kCoin:
+				OnPlayerCoinCollision(collisionCoins_[event.idB]);
+				break;
+			case Type::kGoal:
+				OnPlayerGoalCollision(collisionGoals_[event.idB]);
+				break;
+			default:
+				break;
+			}
+		} else if (event.typeA == Type::kEnemy && event.typeB == Type::kEnemy) {
+			// 押し戻しで位置が変わるので、重なりは OnEnemyCollision の中でもう一度調べる
+			collisionEnemies_[event.idA]->OnEnemyCollision(collisionEnemies_[event.idB]);
+		}
+	}
+}
 
-	AABB aabbPlayer = player_->GetAABB();
-	AABB aabbEnemy = enemy->GetAABB();
+// =================================
+// プレイヤーと敵キャラが当たったときの処理
+// =================================
+
+void GameScene::OnPlayerEnemyCollision(Enemy* enemy) {
 
-	if (!AABB::CheckCollision(aabbPlayer, aabbEnemy)) {
-		return;
-	}
 	if (enemy->IsDead()) {
 		return;
 	}
 
-	player;
+	enemy->OnPlayerCollision(player_);
 }
 
 // =================================
@@ -487,49 +637,45 @@ void GameScene::UpdateFadeInPhase() {
 		camera_.TransferMatrix();
 	}
 
-	for (auto& worldTransformLine : mapChipField_->worldTransformBlocks_) {
-		for (auto* worldTransformBlock : worldTransformLine) {
-			if (!worldTransformBlock)
-				continue;
-			using namespace KamataEngine::MathUtility;
-			Matrix4x4 scaleMat = MakeScaleMatrix(worldTransformBlock->scale_);
-			Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransformBlock->rotation_.z);
-			Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransformBlock->rotation_.y);
-			Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransformBlock->rotation_.x);
-			Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-			Matrix4x4 transMat = MakeTranslateMatrix(worldTransformBlock->translation_);
-			worldTransformBlock->matWorld_ = scaleMat * rotMat * transMat;
-			worldTransformBlock->TransferMatrix();
-		}
-	}
+	// カメラに近づいたチャンクを読み込み、後ろのチャンクを捨てる
+	mapChipField_->UpdateStreaming(camera_.translation_.x);
 
+	UpdateActiveRegion();
+
+	player_->HandleInput();
 	player_->SetDeltaTime(0.0f);
 	player_->Update();
-	player_->SetDeltaTime(deltaTime_);
 
-	for (Enemy* enemy : enemies_) {
-		if (!enemy)
+	for (Enemy& enemy : enemies_) {
+		if (!IsInActiveRegion(enemy.GetAABB()))
 			continue;
-		enemy->SetDeltaTime(0.0f);
-		enemy->Update();
-		enemy->SetDeltaTime(deltaTime_);
+		enemy.SetDeltaTime(0.0f);
+		enemy.Update();
 	}
 
-	for (Coin* coin : coins_) {
-		if (!coin)
+	// マップとの当たり判定を全キャラクターまとめて解く
+	kinematicBodies_.ResolveMapCollisions();
+
+	player_->UpdateAfterMapCollision();
+	player_->SetDeltaTime(deltaTime_);
+
+	for (Enemy& enemy : enemies_) {
+		if (!IsInActiveRegion(enemy.GetAABB()))
 			continue;
-		coin->SetDeltaTime(0.0f);
-		coin->Update();
-		coin->SetDeltaTime(deltaTime_);
+		enemy.UpdateAfterMapCollision();
+		enemy.SetDeltaTime(deltaTime_);
 	}
 
-	for (Goal* goal : goals_) {
-		if (!goal)
-			continue;
-		goal->SetDeltaTime(0.0f);
-		goal->Update();
-		goal->SetDeltaTime(deltaTime_);
+	// 止まっているので補間はせず、プレイヤーと見えている敵の行列だけ作る
+	player_->InterpolateTransform(1.0f);
+	for (Enemy& enemy : enemies_) {
+		if (IsInVisibleRegion(enemy.GetAABB())) {
+			enemy.InterpolateTransform(1.0f);
+		}
 	}
+
+	// コイン・ゴールは位相を進めずに行列だけ作る（見えているものだけ）
+	props_.UpdateTransforms(RectToAABB(visibleRegion_));
 }
 
 // =================================
@@ -578,79 +724,38 @@ void GameScene::UpdatePlayPhase() {
 
 	skydome_->Update();
 
-	// ============================
-	// プレイヤーの更新
-	// ============================
-
-	player_->Update();
+	// 押した瞬間の入力は毎フレーム拾っておき、次の固定ステップで使う
+	player_->HandleInput();
 
 	// ============================
-	// パーティクルの更新
+	// 固定ステップでゲームを進める
 	// ============================
 
-	// ============================
-	// 敵の更新
-	// ============================
-
-	// --- 敵の更新（死亡スキップ） ---
-	for (Enemy* enemy : enemies_) {
-		if (enemy && !enemy->IsDead()) {
-			enemy->Update();
+	for (uint32_t step = 0; step < fixedSteps_; ++step) {
+		StepPlayPhase();
+		// 死亡・クリアでフェーズが変わったら残りのステップは進めない
+		if (phase_ != Phase::kPlay) {
+			break;
 		}
 	}
 
-	// --- 死亡した敵の破棄 ---
-	enemies_.remove_if([&](Enemy* e) {
-		if (!e) {
-			return true;
-		}
-		if (e->IsDead()) {
-			delete e;
-			return true;
-		}
-		return false;
-	});
-
-	// ============================
-	// コインの更新
-	// ============================
-
-	for (Coin* coin : coins_) {
-		if (coin) {
-			coin->Update();
+	// 描画用に、直前のステップと現在の位置の間を補間する（敵は見えているものだけ）
+	player_->InterpolateTransform(interpolationAlpha_);
+	for (Enemy& enemy : enemies_) {
+		if (!enemy.IsDead() && IsInVisibleRegion(enemy.GetAABB())) {
+			enemy.InterpolateTransform(interpolationAlpha_);
 		}
 	}
 
-	// ============================
-	// ゴールの更新
-	// ============================
-
-	for (Goal* goal : goals_) {
-		if (goal) {
-			goal->Update();
-		}
-	}
+	// コイン・ゴールの行列は、動いたもののうち見えているものだけ作り直す
+	props_.UpdateTransforms(RectToAABB(visibleRegion_));
 
 	// ============================
 	// ブロックの更新
 	// ============================
 
-	for (auto& worldTransformLine : mapChipField_->worldTransformBlocks_) {
-		for (auto* worldTransformBlock : worldTransformLine) {
-			if (!worldTransformBlock)
-				continue;
-
-			using namespace KamataEngine::MathUtility;
-			Matrix4x4 scaleMat = MakeScaleMatrix(worldTransformBlock->scale_);
-			Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransformBlock->rotation_.z);
-			Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransformBlock->rotation_.y);
-			Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransformBlock->rotation_.x);
-			Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-			Matrix4x4 transMat = MakeTranslateMatrix(worldTransformBlock->translation_);
-			worldTransformBlock->matWorld_ = scaleMat * rotMat * transMat;
-			worldTransformBlock->TransferMatrix();
-		}
-	}
+	// カメラに近づいたチャンクを読み込み、後ろのチャンクを捨てる
+	mapChipField_->UpdateStreaming(camera_.translation_.x);
 
 #ifdef _DEBUG
 
@@ -717,6 +822,149 @@ void GameScene::UpdatePlayPhase() {
 		ImGui::Text("Z: %.2f", camera_.translation_.z);
 	}
 
+	if (ImGui::CollapsingHeader("ステージ読み込み")) {
+		const float megaBytes = static_cast<float>(mapChipField_->GetLoadedBytes()) / (1024.0f * 1024.0f);
+		ImGui::Text("形式 : %s", mapChipField_->IsLoadedFromBinary() ? "バイナリ" : "CSV");
+		ImGui::Text("サイズ : %zu bytes", mapChipField_->GetLoadedBytes());
+		ImGui::Text("時間 : %.3f ms", stageLoadMilliseconds_);
+		ImGui::Text("速度 : %.1f MB/s", stageLoadMilliseconds_ > 0.0f ? megaBytes / (stageLoadMilliseconds_ / 1000.0f) : 0.0f);
+		const MapChipField::MemoryUsage memory = mapChipField_->GetMemoryUsage();
+		ImGui::Text("ステージ全体 : タイル %zu / ビット %zu bytes", memory.tileBytes, memory.solidBitBytes);
+		ImGui::Text("読み込み中のチャンク : %zu bytes", memory.blockChunkBytes);
+		ImGui::Text("敵の生成 : %zu 体 / %.1f us", mapChipField_->GetEnemySpawnIndices().size(), enemySpawnMicroseconds_);
+		if (ImGui::Button("CSV読み込みベンチマーク")) {
+			csvLoadBenchmark_ = RunCsvLoadBenchmark(50000, 20);
+		}
+		if (csvLoadBenchmark_.byteSize > 0) {
+			const CsvLoadBenchmark& bench = csvLoadBenchmark_;
+			ImGui::Text("%u x %u (%zu bytes)", bench.numRows, bench.numColumns, bench.byteSize);
+			ImGui::Text("旧ローダー : %.1f MB/s", bench.referenceMegaBytesPerSecond);
+			ImGui::Text("スキャナ : %.1f MB/s", bench.scannerMegaBytesPerSecond);
+			ImGui::Text("結果の一致 : %s", bench.resultsMatch ? "OK" : "NG");
+		}
+	}
+
+	if (ImGui::CollapsingHeader("ブロックの描画")) {
+		// インスタンスは読み込まれているチャンクの分だけ持つ
+		size_t instanceCount = 0;
+		size_t instanceBytes = 0;
+		for (const MapChipField::BlockChunk& chunk : mapChipField_->GetResidentBlockChunks()) {
+			instanceCount += chunk.instances.GetInstances().size();
+			instanceBytes += chunk.instances.GetByteSize();
+		}
+		ImGui::Text("インスタンス : %zu (%zu bytes)", instanceCount, instanceBytes);
+		ImGui::Text("描画呼び出し : %u  送ったインスタンス : %u (%zu bytes)", blockRenderer_.GetDrawCallCount(), blockRenderer_.GetDrawnCount(), blockRenderer_.GetUploadedBytes());
+		ImGui::Text("静的メッシュ（データのみ・描画しない）");
+		if (ImGui::Button("メッシュを焼く")) {
+			const auto bakeBegin = std::chrono::steady_clock::now();
+			staticMapMesh_.Bake(*mapChipField_);
+			staticMapMeshBakeMilliseconds_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - bakeBegin).count();
+		}
+		if (!staticMapMesh_.GetChunkMeshes().empty()) {
+			ImGui::Text("チャンク : %zu  時間 : %.3f ms", staticMapMesh_.GetChunkMeshes().size(), staticMapMeshBakeMilliseconds_);
+			ImGui::Text("頂点 : %zu  三角形 : %zu", staticMapMesh_.GetVertexCount(), staticMapMesh_.GetTriangleCount());
+			ImGui::Text("削った面 : %zu", staticMapMesh_.GetRemovedFaceCount());
+		}
+		if (ImGui::Button("メッシュの検証")) {
+			staticMapMeshCheck_ = RunStaticMapMeshCheck("Resources/csv");
+		}
+		if (staticMapMeshCheck_.checked) {
+			for (uint32_t i = 0; i < StaticMapMeshCheck::kStageCount; ++i) {
+				const StaticMapMeshCheck::Stage& stage = staticMapMeshCheck_.stages[i];
+				if (!stage.loaded) {
+					ImGui::Text("stage%u : 読み込めません", i + 1);
+					continue;
+				}
+				ImGui::Text("stage%u : 頂点 %zu  三角形 %zu  削った面 %zu  %s", i + 1, stage.vertexCount, stage.triangleCount, stage.removedFaceCount, stage.match ? "OK" : "NG");
+			}
+			ImGui::Text("検証 : %s", staticMapMeshCheck_.allMatch ? "OK" : "NG");
+		}
+	}
+
+	if (ImGui::CollapsingHeader("カリング")) {
+		ImGui::Text("可視範囲 : X %.1f ~ %.1f  Y %.1f ~ %.1f", visibleRegion_.left, visibleRegion_.right, visibleRegion_.bottom, visibleRegion_.top);
+		ImGui::Text("ブロック : 描画 %u / 除外 %u", blockRenderer_.GetDrawnCount(), blockRenderer_.GetCulledCount());
+		ImGui::Text("敵・コイン・ゴール : 描画 %u / 除外 %u", submittedEntityCount_, culledEntityCount_);
+	}
+
+	if (ImGui::CollapsingHeader("行列の更新")) {
+		const TransformCache::FrameStats transformStats = TransformCache::GetFrameStats();
+		ImGui::Text("作り直した行列 : %u", transformStats.rebuiltMatrices);
+		ImGui::Text("転送 : %zu bytes", transformStats.uploadedBytes);
+		if (ImGui::Button("行列の合成ベンチマーク")) {
+			composeTRSBenchmark_ = RunComposeTRSBenchmark(100000);
+		}
+		if (composeTRSBenchmark_.transformCount > 0) {
+			const ComposeTRSBenchmark& bench = composeTRSBenchmark_;
+			ImGui::Text("%zu 個", bench.transformCount);
+			ImGui::Text("MathUtility : %.1f ns/個", bench.mathUtilityNanoseconds);
+			ImGui::Text("ComposeTRS : %.1f ns/個", bench.composeNanoseconds);
+			ImGui::Text("一括 (%s) : %.1f ns/個", FastMath::GetKernelName(), bench.batchNanoseconds);
+			ImGui::Text("最大誤差 : %g", bench.maxError);
+		}
+	}
+
+	if (ImGui::CollapsingHeader("シーンのメモリ")) {
+		ImGui::Text("使用量 : %zu bytes", arena_.GetUsedBytes());
+		ImGui::Text("ブロック数 : %zu", arena_.GetBlockCount());
+		ImGui::Text("破棄するオブジェクト : %zu", arena_.GetObjectCount());
+	}
+
+	if (ImGui::CollapsingHeader("アクティブ範囲")) {
+		const auto isActive = [&](auto& object) { return IsInActiveRegion(object.GetAABB()); };
+		ImGui::Text("範囲 : X %.1f ~ %.1f  Y %.1f ~ %.1f", activeRegion_.left, activeRegion_.right, activeRegion_.bottom, activeRegion_.top);
+		ImGui::Text("敵 : %zu / %zu", static_cast<size_t>(std::count_if(enemies_.begin(), enemies_.end(), isActive)), enemies_.size());
+		const auto countProps = [&](uint32_t kind, bool activeOnly) {
+			size_t count = 0;
+			for (EntityWorld::EntityId id = 0; id < props_.Size(); ++id) {
+				if (props_.HasFlags(id, kind) && (!activeOnly || IsInActiveRegion(props_.GetAABB(id)))) {
+					++count;
+				}
+			}
+			return count;
+		};
+		ImGui::Text("コイン : %zu / %zu", countProps(kEntityCoin, true), countProps(kEntityCoin, false));
+		ImGui::Text("ゴール : %zu / %zu", countProps(kEntityGoal, true), countProps(kEntityGoal, false));
+	}
+
+	if (ImGui::CollapsingHeader("当たり判定")) {
+		ImGui::Text("一括判定 : %s", AABBBatch::GetKernelName());
+		ImGui::Text("箱 : 敵 %zu  コイン %zu  ゴール %zu", enemyBoxes_.Size(), coinBoxes_.Size(), goalBoxes_.Size());
+		ImGui::Text("敵同士の組 : %zu", collisionPairs_.size());
+		ImGui::Text("当たりの記録 : %zu", collisionEvents_.Size());
+		if (ImGui::Button("一括判定ベンチマーク")) {
+			aabbBatchBenchmark_ = RunAABBBatchBenchmark(4096, 2000);
+		}
+		if (aabbBatchBenchmark_.boxCount > 0) {
+			const AABBBatchBenchmark& bench = aabbBatchBenchmark_;
+			ImGui::Text("%zu 箱 x %u 回", bench.boxCount, bench.queryCount);
+			ImGui::Text("スカラー : %.3f ns/箱", bench.scalarNanosecondsPerBox);
+			ImGui::Text("%s : %.3f ns/箱 (x%.1f)", AABBBatch::GetKernelName(), bench.simdNanosecondsPerBox,
+			            bench.simdNanosecondsPerBox > 0.0 ? bench.scalarNanosecondsPerBox / bench.simdNanosecondsPerBox : 0.0);
+			ImGui::Text("結果の一致 : %s", bench.resultsMatch ? "OK" : "NG");
+		}
+	}
+
+	if (ImGui::CollapsingHeader("負荷試験")) {
+		if (stressEntities_.Size() == 0) {
+			if (ImGui::Button("動くエンティティを出す")) {
+				SpawnStressEntities();
+			}
+		} else if (ImGui::Button("消す")) {
+			stressEntities_.Clear();
+			stressBoxes_.Clear();
+			stressPlayerHits_ = 0;
+		}
+		ImGui::Text("数 : %zu", stressEntities_.Size());
+		ImGui::Text("1ステップ : %.3f ms", stressStepMilliseconds_);
+		ImGui::Text("アクティブ範囲内 : %zu  プレイヤーと重なり : %zu", stressBoxes_.Size(), stressPlayerHits_);
+	}
+
+	if (ImGui::CollapsingHeader("並列更新")) {
+		ImGui::Checkbox("敵を並列に更新", &parallelEnemyUpdate_);
+		ImGui::Text("ワーカー : %u スレッド", jobSystem_.GetWorkerCount());
+	}
+
 	ImGui::End();
 
 #endif // _DEBUG
@@ -728,9 +976,55 @@ void GameScene::UpdatePlayPhase() {
 	}
 
 	camera_.UpdateMatrix();
+}
+
+// =================================
+// プレイフェーズの固定ステップ1回分
+// =================================
+
+void GameScene::StepPlayPhase() {
+
+	// アクティブ範囲をプレイヤーの位置に合わせる（範囲外の敵・コイン・ゴールはこのステップでは動かさない）
+	UpdateActiveRegion();
+
+	// ============================
+	// プレイヤーの更新
+	// ============================
+
+	player_->Update();
+
+	// ============================
+	// パーティクルの更新
+	// ============================
+
+	// ============================
+	// 敵の更新
+	// ============================
+
+	// 敵の移動とマップとの当たり判定（プレイヤーのボディもここで一緒に解く）
+	StepEnemies();
+
+	player_->UpdateAfterMapCollision();
+
+	// --- 死亡した敵を巡回から外す（破棄はフレームの終わりにまとめて行う） ---
+	enemies_.DespawnIf([](const Enemy& enemy) { return enemy.IsDead(); });
+
+	// ============================
+	// コイン・ゴールの更新
+	// ============================
+
+	// 回転の位相を進める（使う配列だけをなめる。行列はフレームの終わりに見えているものだけ作る）
+	props_.AdvanceAnimation(deltaTime_, RectToAABB(activeRegion_));
+
+	// 負荷試験のエンティティ（デバッグで出したときだけ）
+	if (stressEntities_.Size() > 0) {
+		StepStressEntities();
+	}
 
 	// 当たり判定のチェック
+	// 当たり判定では記録を積むだけにして、反応は後からまとめて順番に処理する
 	CheckAllCollisions();
+	HandleCollisionEvents();
 
 	// ▼▼ 奈落チェック：プレイ範囲外に落ちたら即デスフェーズへ ▼▼
 	{
@@ -741,7 +1035,7 @@ void GameScene::UpdatePlayPhase() {
 
 			// デス演出フェーズへ（既存のフェーズ遷移仕様に合わせる）
 			ChangePhase(); // kPlay -> kDeath
-			return;        // このフレームの残処理を打ち切り
+			return;        // このステップの残処理を打ち切り
 		}
 	}
 
@@ -765,33 +1059,28 @@ void GameScene::DrawPlayPhase() {
 	// プレイヤーの描画
 	player_->Draw();
 
-	// 敵の描画
-	for (Enemy* enemy : enemies_) {
-		if (enemy) {
-			enemy->Draw();
-		}
-	}
+	submittedEntityCount_ = 0;
+	culledEntityCount_ = 0;
 
-	for (Coin* coin : coins_) {
-		if (coin) {
-			coin->Draw();
+	// 敵の描画
+	for (Enemy& enemy : enemies_) {
+		if (IsInVisibleRegion(enemy.GetAABB())) {
+			enemy.Draw();
+			++submittedEntityCount_;
+		} else {
+			++culledEntityCount_;
 		}
 	}
 
-	for (Goal* goal : goals_) {
-		if (goal) {
-			goal->Draw();
-		}
-	}
+	// コイン・ゴールの描画
+	const uint32_t propCandidates = static_cast<uint32_t>(props_.Count(kEntityDrawable, kEntityCollected));
+	uint32_t propSubmitted = props_.Draw(kEntityCoin, RectToAABB(visibleRegion_), coinModel_, camera_);
+	propSubmitted += props_.Draw(kEntityGoal, RectToAABB(visibleRegion_), goalModel_, camera_);
+	submittedEntityCount_ += propSubmitted;
+	culledEntityCount_ += propCandidates - propSubmitted;
 
 	// ブロックの描画
-	for (auto& worldTransformLine : mapChipField_->worldTransformBlocks_) {
-		for (auto* worldTransformBlock : worldTransformLine) {
-			if (!worldTransformBlock)
-				continue;
-			model_->Draw(*worldTransformBlock, camera_, textureHandle_);
-		}
-	}
+	blockRenderer_.Draw(*mapChipField_, camera_, visibleRegion_);
 }
 
 void GameScene::UpdateDeathPhase() {
@@ -803,12 +1092,21 @@ void GameScene::UpdateDeathPhase() {
 	skydome_->Update();
 
 	// ============================
-	// 敵の更新
+	// 固定ステップで敵とパーティクルを進める
 	// ============================
 
-	for (Enemy* enemy : enemies_) {
-		if (enemy) {
-			enemy->Update();
+	for (uint32_t step = 0; step < fixedSteps_; ++step) {
+		StepDeathPhase();
+		// 演出が終わってフェーズが変わったら残りのステップは進めない
+		if (phase_ != Phase::kDeath) {
+			break;
+		}
+	}
+
+	// 描画用に、直前のステップと現在の位置の間を補間する（見えているものだけ）
+	for (Enemy& enemy : enemies_) {
+		if (IsInVisibleRegion(enemy.GetAABB())) {
+			enemy.InterpolateTransform(interpolationAlpha_);
 		}
 	}
 
@@ -816,22 +1114,8 @@ void GameScene::UpdateDeathPhase() {
 	// ブロックの更新
 	// ============================
 
-	for (auto& worldTransformLine : mapChipField_->worldTransformBlocks_) {
-		for (auto* worldTransformBlock : worldTransformLine) {
-			if (!worldTransformBlock)
-				continue;
-
-			using namespace KamataEngine::MathUtility;
-			Matrix4x4 scaleMat = MakeScaleMatrix(worldTransformBlock->scale_);
-			Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransformBlock->rotation_.z);
-			Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransformBlock->rotation_.y);
-			Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransformBlock->rotation_.x);
-			Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-			Matrix4x4 transMat = MakeTranslateMatrix(worldTransformBlock->translation_);
-			worldTransformBlock->matWorld_ = scaleMat * rotMat * transMat;
-			worldTransformBlock->TransferMatrix();
-		}
-	}
+	// カメラに近づいたチャンクを読み込み、後ろのチャンクを捨てる
+	mapChipField_->UpdateStreaming(camera_.translation_.x);
 
 #ifdef _DEBUG
 
@@ -895,11 +1179,32 @@ void GameScene::UpdateDeathPhase() {
 		ImGui::Text("Z: %.2f", camera_.translation_.z);
 	}
 
+	if (ImGui::CollapsingHeader("ステージ読み込み")) {
+		const float megaBytes = static_cast<float>(mapChipField_->GetLoadedBytes()) / (1024.0f * 1024.0f);
+		ImGui::Text("形式 : %s", mapChipField_->IsLoadedFromBinary() ? "バイナリ" : "CSV");
+		ImGui::Text("サイズ : %zu bytes", mapChipField_->GetLoadedBytes());
+		ImGui::Text("時間 : %.3f ms", stageLoadMilliseconds_);
+		ImGui::Text("速度 : %.1f MB/s", stageLoadMilliseconds_ > 0.0f ? megaBytes / (stageLoadMilliseconds_ / 1000.0f) : 0.0f);
+	}
+
 	ImGui::End();
 
 #endif // _DEBUG
 
 	camera_.UpdateMatrix();
+}
+
+// =================================
+// デスフェーズの固定ステップ1回分
+// =================================
+
+void GameScene::StepDeathPhase() {
+
+	// ============================
+	// 敵の更新
+	// ============================
+
+	StepEnemies();
 
 	if (deathParticles_ && deathParticles_->GetIsFinished()) {
 		// パーティクルが終了したらフェーズを変更
@@ -919,21 +1224,24 @@ void GameScene::DrawDeathPhase() {
 	// パーティクルの描画
 	deathParticles_->Draw();
 
+	submittedEntityCount_ = 0;
+	culledEntityCount_ = 0;
+
 	// 敵の描画
-	for (Enemy* enemy : enemies_) {
-		if (enemy && !enemy->IsDead()) {
-			enemy->Draw();
+	for (Enemy& enemy : enemies_) {
+		if (enemy.IsDead()) {
+			continue;
+		}
+		if (IsInVisibleRegion(enemy.GetAABB())) {
+			enemy.Draw();
+			++submittedEntityCount_;
+		} else {
+			++culledEntityCount_;
 		}
 	}
 
 	// ブロックの描画
-	for (auto& worldTransformLine : mapChipField_->worldTransformBlocks_) {
-		for (auto* worldTransformBlock : worldTransformLine) {
-			if (!worldTransformBlock)
-				continue;
-			model_->Draw(*worldTransformBlock, camera_, textureHandle_);
-		}
-	}
+	blockRenderer_.Draw(*mapChipField_, camera_, visibleRegion_);
 
 }
 
@@ -970,13 +1278,7 @@ void GameScene::ComputeResult() {
 	// 総コイン数はCSV由来のスポーン数を採用（描画漏れ等の影響を受けない）
 	totalCoins_ = static_cast<int>(mapChipField_->GetCoinSpawnIndices().size());
 
-	int collected = 0;
-	for (Coin* c : coins_) {
-		if (c && c->IsCollected()) {
-			++collected;
-		}
-	}
-	collectedCoins_ = collected;
+	collectedCoins_ = CountCollectedCoins();
 
 	// ☆は「全体の1/3ごとに1個（最大3）」を切り上げ単位で計算
 	// 例：総数10 → 区切り=ceil(10/3)=4 → 0~3, 4~7, 8~10 の3段階
@@ -1026,43 +1328,72 @@ void GameScene::DrawResultOverlay() {
 #endif // _DEBUG
 }
 
-void GameScene::CheckPlayerCoinCollisions(Player* player, Coin* coin) {
-	AABB aabbPlayer = player_->GetAABB();
-	AABB aabbCoin = coin->GetAABB();
+void GameScene::OnPlayerCoinCollision(EntityWorld::EntityId coin) {
+	// プレイヤーに触れたら取得扱い
+	props_.AddFlags(coin, kEntityCollected);
+	// 必要ならスコア加算や UI 更新などをここに
+}
+
+void GameScene::OnPlayerGoalCollision(EntityWorld::EntityId goal) {
+	props_.AddFlags(goal, kEntityReached);
+	if (!isCleared_) {
+		isCleared_ = true;
 
-	if (AABB::CheckCollision(aabbPlayer, aabbCoin)) {
-		coin->OnPlayerCollision(player);
-		// 必要ならスコア加算や UI 更新などをここに
+		//CommonBGM::GetInstance()->Stop();
+
+		//Audio::GetInstance()->PlayWave(soundDataHandle_);
+		ComputeResult();
+		fade_->Start(Fade::Status::FadeOut, 0.8f);
+		phase_ = Phase::kResult;
+		resultWaitingInput_ = false;
 	}
 }
 
-void GameScene::CheckPlayerGoalCollisions(Player* player, Goal* goal) {
-	AABB aabbPlayer = player_->GetAABB();
-	AABB aabbGoal = goal->GetAABB();
-	if (AABB::CheckCollision(aabbPlayer, aabbGoal)) {
-		goal->OnPlayerCollision(player);
-		if (!isCleared_) {
-			isCleared_ = true;
-
-			//CommonBGM::GetInstance()->Stop();
-
-			//Audio::GetInstance()->PlayWave(soundDataHandle_);
-			ComputeResult();
-			fade_->Start(Fade::Status::FadeOut, 0.8f);
-			phase_ = Phase::kResult;
-			resultWaitingInput_ = false;
-		}
+int GameScene::CountCollectedCoins() const { return static_cast<int>(props_.Count(kEntityCoin | kEntityCollected)); }
+
+// =================================
+// 負荷試験（デバッグ用）
+// =================================
+
+void GameScene::SpawnStressEntities() {
+
+	// プレイ範囲全体に、ばらばらの向き・速さで出す（乱数は固定）
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> positionX(playArea_.left, playArea_.right);
+	std::uniform_real_distribution<float> positionY(playArea_.bottom, playArea_.top);
+	std::uniform_real_distribution<float> speed(-4.0f, 4.0f);
+
+	stressEntities_.Clear();
+	stressEntities_.Reserve(kStressEntityCount);
+	for (uint32_t i = 0; i < kStressEntityCount; ++i) {
+		EntityWorld::Desc walker;
+		walker.position = {positionX(random), positionY(random), 0.0f};
+		walker.velocity = {speed(random), speed(random), 0.0f};
+		walker.halfExtent = {0.45f, 0.45f, 0.45f};
+		walker.rotateSpeed = kCoinRotateSpeed;
+		walker.flags = kEntityWalker | kEntityMoving | kEntityAnimated;
+		stressEntities_.Create(walker);
 	}
 }
 
-int GameScene::CountCollectedCoins() const {
-	int cnt = 0;
-	for (Coin* c : coins_) {
-		if (c && c->IsCollected()) {
-			++cnt;
-		}
-	}
-	return cnt;
+void GameScene::StepStressEntities() {
+
+	const auto begin = std::chrono::steady_clock::now();
+
+	// 移動 → アニメーション → 行列 → 当たり判定の箱、をそれぞれ必要な配列だけで回す
+	const AABB playArea = RectToAABB(playArea_);
+	stressEntities_.IntegrateVelocities(deltaTime_, playArea);
+	stressEntities_.AdvanceAnimation(deltaTime_, playArea);
+	stressEntities_.UpdateTransforms(playArea);
+
+	stressBoxes_.Clear();
+	stressIds_.clear();
+	stressEntities_.CollectAABBs(kEntityWalker, 0, RectToAABB(activeRegion_), stressBoxes_, stressIds_);
+	stressBoxes_.Overlap(player_->GetAABB(), collisionHits_);
+	stressPlayerHits_ = 0;
+	AABBBatch::ForEachHit(collisionHits_, [&](uint32_t) { ++stressPlayerHits_; });
+
+	stressStepMilliseconds_ = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
 }
 
 void GameScene::UpdatePauseOverlay() {
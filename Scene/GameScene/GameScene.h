@@ -5,13 +5,23 @@
 #include "MapChipField/MapChipField.h"
 #include "Player/player.h"
 #include "Skydome/Skydome.h"
+#include "SpatialHash/SpatialHash.h"
+#include "AABBBatch/AABBBatch.h"
+#include "JobSystem/JobSystem.h"
+#include "CollisionEvent/CollisionEvent.h"
+#include "SlotMap/SlotMap.h"
+#include "BlockRenderer/BlockRenderer.h"
+#include "BlockRenderer/StaticMapMesh.h"
+#include "SceneArena/SceneArena.h"
+#include "FastMath/FastMath.h"
+#include "TransformCache/TransformCache.h"
 #include "fade/fade.h"
-#include "Coin/Coin.h"
-#include "Goal/Goal.h"
+#include "EntityWorld/EntityWorld.h"
 #include "struct.h"
 #include <KamataEngine.h>
+#include <cassert>
+#include <chrono>
 #include <vector>
-#include <list>
 
 using namespace KamataEngine;
 
@@ -37,23 +47,36 @@ public:
 
 	bool GetIsFinished() const { return isFinished_; } // シーン終了フラグの取得
 
+	/// <summary>
+	/// 当たり判定を行い、当たった組を collisionEvents_ に積みます（状態は書き換えません）。
+	/// </summary>
 	void CheckAllCollisions();
 
 	/// <summary>
-	/// プレイヤーと敵キャラクターの衝突をチェックします。
+	/// 積まれた当たりを順番に処理します（取得・ゴールなどの反応はここでだけ行います）。
 	/// </summary>
-	void CheckPlayerEnemyCollisions(Player* player, Enemy* enemy);
-
-	void CheckPlayerCoinCollisions(Player* player, Coin* coin);
-
-	void CheckPlayerGoalCollisions(Player* player, Goal* goal);
+	void HandleCollisionEvents();
 
 	void SetStageCSV(const std::string& path) { stageCSVPath_ = path; }
 
+	// 今フレームの経過時間・進める固定ステップ数・描画の補間係数（Game が毎フレーム Update の前に渡す）
+	void SetFrameTiming(float frameDeltaTime, uint32_t fixedSteps, float interpolationAlpha) {
+		frameDeltaTime_ = frameDeltaTime;
+		fixedSteps_ = fixedSteps;
+		interpolationAlpha_ = interpolationAlpha;
+	}
+
 private:
+	// シーンで作るもの（マップ・プレイヤー・モデル・フェードなど）はすべてここから作り、~GameScene でまとめて破棄する
+	SceneArena arena_;
+
 	bool isFinished_ = false; // シーン終了フラグ
 
-	float deltaTime_ = 1.0f / 60.0f; // フレームレートを60FPSに設定
+	float deltaTime_ = 1.0f / 60.0f; // 固定ステップ1回の時間（Game::kFixedDeltaTime と同じ）
+
+	float frameDeltaTime_ = 1.0f / 60.0f; // 今フレームの経過時間（フェード・カメラ用）
+	uint32_t fixedSteps_ = 1;             // 今フレームに進める固定ステップ数
+	float interpolationAlpha_ = 1.0f;     // 直前のステップから次のステップまでの割合（描画の補間用）
 
 	int totalCoins_ = 0;
 	int collectedCoins_ = 0;
@@ -67,6 +90,31 @@ private:
 	// ▼ 位置がプレイ範囲外（奈落含む）か？
 	bool IsOutOfPlayableArea(const Vector3& p) const;
 
+	// ▼ アクティブ範囲（カメラの周り）。外にいる敵・コイン・ゴールは更新も描画もしない
+	static inline const float kActiveRegionMargin = 12.0f; // 視野の外側の余白（カメラの先読み分を含む）
+	Rect cameraMovableArea_{};   // カメラの可動域（範囲の中心をカメラと同じく制限する）
+	float activeHalfWidth_ = 0.0f;  // 視野の半分 + 余白
+	float activeHalfHeight_ = 0.0f;
+	Rect activeRegion_{};
+
+	// シミュレーション上のプレイヤー位置からアクティブ範囲を決め直す
+	void UpdateActiveRegion();
+	bool IsInActiveRegion(const AABB& aabb) const;
+
+	// ▼ 可視範囲（カメラに映る範囲）。外にあるものは行列も作らず描画にも出さない
+	// 範囲はフレームの頭に直前のカメラ位置から決め、そのフレームの行列の更新と描画で同じものを使う
+	static inline const float kVisibleRegionMargin = 2.0f; // 奥行きのあるブロックの見切れと、1フレーム分のカメラの移動の余白
+	float viewHalfWidth_ = 0.0f;  // z = 0 の平面での視野の半分
+	float viewHalfHeight_ = 0.0f;
+	Rect visibleRegion_{};
+
+	void UpdateVisibleRegion();
+	bool IsInVisibleRegion(const AABB& aabb) const;
+
+	// 直前のフレームで描画に出した敵・コイン・ゴールの数と、見えていないので外した数（デバッグ表示用）
+	uint32_t submittedEntityCount_ = 0;
+	uint32_t culledEntityCount_ = 0;
+
 	std::string stageCSVPath_ = "Resources/csv/stage1.csv";
 
 	//========================
@@ -80,9 +128,14 @@ private:
 	void UpdateFadeInPhase();
 
 	void UpdatePlayPhase();
+	void StepPlayPhase();
 	void DrawPlayPhase();
 
 	void UpdateDeathPhase();
+	void StepDeathPhase();
+
+	// 敵の更新（移動 → マップ判定 → 判定後の処理）。各段を敵ごとに分けて並列に処理する
+	void StepEnemies();
 	void DrawDeathPhase();
 
 	void UpdateResultPhase();
@@ -109,6 +162,11 @@ private:
 	// =======================
 
 	MapChipField* mapChipField_ = nullptr;
+	KinematicBodySystem kinematicBodies_; // プレイヤー・敵のマップ当たり判定
+	float stageLoadMilliseconds_ = 0.0f; // ステージ読み込みにかかった時間（デバッグ表示用）
+#ifdef _DEBUG
+	CsvLoadBenchmark csvLoadBenchmark_; // デバッグ表示用
+#endif // _DEBUG
 
 	// =======================
 	// 天球
@@ -133,32 +191,102 @@ private:
 	// 敵キャラクター
 	// =======================
 
-	std::list<Enemy*> enemies_;
+	// 敵は容量を決めて確保した SlotMap に置く（プレイ中の生成・破棄でメモリを確保しない）
+	// 容量はステージの配置数 + 余裕分
+	static inline const uint32_t kSpawnSpareCapacity = 16;
+
+	SlotMap<Enemy> enemies_;
 	KamataEngine::Model* enemyModel_ = nullptr;
 
+	// 敵の生成はこの共有設定から行う（モデル・カメラ・マップは全員で同じものを参照する）
+	Enemy::Prototype enemyPrototype_;
+	float enemySpawnMicroseconds_ = 0.0f; // ステージの敵をすべて生成するのにかかった時間（デバッグ表示用）
+
+	// position に敵を1体作る（満杯なら nullptr）
+	Enemy* SpawnEnemy(const Vector3& position);
+
+	// 敵の更新はジョブシステムで分けて処理する
+	// 各敵は自分の状態・ボディ・WorldTransform しか書き換えないので、順番に処理したときと結果は同じ
+	// 敵同士・プレイヤーとの当たり（OnEnemyCollision など）は、その後に決まった順番で処理する
+	static inline const uint32_t kEnemyGrainSize = 16; // 1つのジョブで受け持つ敵の数
+	JobSystem jobSystem_;
+	bool parallelEnemyUpdate_ = true;  // false なら順番に処理する（デバッグ比較用）
+	std::vector<Enemy*> activeEnemies_; // このステップで動かす敵（毎ステップ作り直す）
+
 	// =======================
 	// ブロック
 	// =======================
-	KamataEngine::Model* model_ = nullptr;
 	// テクスチャハンドル
 	uint32_t textureHandle_ = 0;
-	// 可変個配列
-	std::vector<std::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_;
+	BlockRenderer blockRenderer_;
+
+#ifdef _DEBUG
+	// チャンクごとにまとめたブロックのメッシュ（データだけで描画はしない。デバッグ画面から焼いたときだけ作る）
+	StaticMapMesh staticMapMesh_;
+	float staticMapMeshBakeMilliseconds_ = 0.0f; // 焼くのにかかった時間（デバッグ表示用）
+	StaticMapMeshCheck staticMapMeshCheck_;      // デバッグ表示用
+#endif // _DEBUG
 
 	// =======================
-	// コイン
+	// コイン・ゴール
 	// =======================
-	std::list<Coin*> coins_;
+
+	// 位置・大きさ・回転の位相・フラグだけの置物なので、まとめて EntityWorld の配列に持つ
+	static inline const float kCoinRotateSpeed = 2.5f;                                // コインの回転速度[rad/s]
+	static inline const float kGoalRotateSpeed = 90.0f * 3.1415926535f / 180.0f;       // ゴールの回転速度[rad/s]
+	EntityWorld props_;
 	KamataEngine::Model* coinModel_ = nullptr;
+	KamataEngine::Model* goalModel_ = nullptr;
+
+	bool isCleared_ = false; // クリアフラグ
 
 	// ========================
-	// ゴール
+	// キャラクター・アイテム同士の当たり判定
 	// ========================
 
-	std::list<Goal*> goals_;
-	KamataEngine::Model* goalModel_ = nullptr;
+	// 敵同士（多対多）は、タイルと同じ大きさのセルで区切って同じセルの組だけ調べる
+	static inline const uint32_t kCollisionEnemy = 1u; // 広域判定の種類
+	SpatialHash collisionHash_;
+	std::vector<SpatialHash::Pair> collisionPairs_; // 重なっている組
 
-	bool isCleared_ = false; // クリアフラグ
+	// プレイヤーとの判定（1対多）は、種類ごとの箱の配列とまとめて比べる
+	AABBBatch enemyBoxes_;
+	AABBBatch coinBoxes_;
+	AABBBatch goalBoxes_;
+	std::vector<uint64_t> collisionHits_; // 当たった箱の番号のビット
+
+	// 箱の番号から引くための一覧（毎ステップ作り直す）
+	std::vector<Enemy*> collisionEnemies_;
+	std::vector<EntityWorld::EntityId> collisionCoins_;
+	std::vector<EntityWorld::EntityId> collisionGoals_;
+
+	// 当たった組の記録（判定で積み、HandleCollisionEvents で処理する）
+	CollisionEventQueue collisionEvents_;
+
+	// 当たったときの反応（HandleCollisionEvents から種類ごとに呼ぶ）
+	void OnPlayerEnemyCollision(Enemy* enemy);
+	void OnPlayerCoinCollision(EntityWorld::EntityId coin);
+	void OnPlayerGoalCollision(EntityWorld::EntityId goal);
+
+#ifdef _DEBUG
+	AABBBatchBenchmark aabbBatchBenchmark_;   // デバッグ表示用
+	ComposeTRSBenchmark composeTRSBenchmark_; // デバッグ表示用
+#endif // _DEBUG
+
+	// ========================
+	// 負荷試験（デバッグ用）
+	// ========================
+
+	// 動き回るだけのエンティティを大量に出し、EntityWorld のシステムが1ステップにかかる時間を測る
+	static inline const uint32_t kStressEntityCount = 10000;
+	EntityWorld stressEntities_;
+	AABBBatch stressBoxes_;
+	std::vector<EntityWorld::EntityId> stressIds_;
+	size_t stressPlayerHits_ = 0;         // プレイヤーと重なった数
+	float stressStepMilliseconds_ = 0.0f; // 直近の1ステップにかかった時間
+
+	void SpawnStressEntities();
+	void StepStressEntities();
 
 	// ========================
 	// 星
@@ -1,4 +1,5 @@
 #include "StageSelectScene.h"
+#include "FastMath/FastMath.h"
 #include "struct.h"
 #include <algorithm>
 
@@ -129,6 +130,8 @@ void StageSelectScene::Initialize() {
 
 void StageSelectScene::Update() {
 
+	fade_->SetDeltaTime(deltaTime_);
+
 #ifdef _DEBUG
 	if (Input::GetInstance()->TriggerKey(DIK_TAB)) {
 		isDebugCameraActive_ = !isDebugCameraActive_;
@@ -341,17 +344,8 @@ void StageSelectScene::StepLayoutAnimation_() {
 }
 
 void StageSelectScene::UpdateAffineTransformMatrix_(WorldTransform& wt) {
-	// スケール
-	Matrix4x4 S = MakeScaleMatrix(wt.scale_);
-	// 回転
-	Matrix4x4 Rz = MakeRotateZMatrix(wt.rotation_.z);
-	Matrix4x4 Ry = MakeRotateYMatrix(wt.rotation_.y);
-	Matrix4x4 Rx = MakeRotateXMatrix(wt.rotation_.x);
-	Matrix4x4 R = Rz * Ry * Rx;
-	// 平行移動
-	Matrix4x4 T = MakeTranslateMatrix(wt.translation_);
 	// アフィン（Player と同じ：S * R * T）
-	wt.matWorld_ = S * R * T;
+	wt.matWorld_ = FastMath::ComposeTRS(wt.scale_, wt.rotation_, wt.translation_);
 
 	// GPU へ
 	wt.TransferMatrix();
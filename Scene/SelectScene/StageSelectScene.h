@@ -23,8 +23,12 @@ public:
 	bool GetIsFinished() const { return isFinished_; }
 	const std::string& GetSelectedStageCSV() const { return selectedStageCSV_; }
 
+	// 前回の Update からの経過時間（秒）
+	void SetDeltaTime(float deltaTime) { deltaTime_ = deltaTime; }
+
 private:
 	bool isFinished_ = false;
+	float deltaTime_ = 1.0f / 60.0f;
 	Phase phase_ = Phase::kFadeIn;
 
 	// カメラ
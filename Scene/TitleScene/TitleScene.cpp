@@ -60,6 +60,8 @@ void TitleScene::Initialize() {
 
 void TitleScene::Update() {
 
+	fade_->SetDeltaTime(deltaTime_);
+
 #ifdef _DEBUG
 	// デバッグカメラの切り替え
 	if (Input::GetInstance()->TriggerKey(DIK_TAB)) {
@@ -26,8 +26,12 @@ public:
 
 	bool GetIsFinished() const { return isFinished_; }
 
+	// 前回の Update からの経過時間（秒）
+	void SetDeltaTime(float deltaTime) { deltaTime_ = deltaTime; }
+
 private:
 	bool isFinished_ = false;
+	float deltaTime_ = 1.0f / 60.0f;
 
 	Camera camera_;
 	DebugCamera* debugCamera_ = nullptr;
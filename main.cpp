@@ -1,11 +1,18 @@
 #include "Game/Game.h"
+#include "StageBinary/StageBinary.h"
 #include <KamataEngine.h>
 #include <Windows.h>
+#include <string_view>
 
 using namespace KamataEngine;
 
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
+int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR lpCmdLine, _In_ int) {
+	// ビルド後イベントから呼ばれたときは、ステージCSVを *.stage に変換するだけで終わる
+	if (std::string_view(lpCmdLine).starts_with("--compile-stages")) {
+		return StageBinary::CompileDirectory("Resources/csv") ? 0 : 1;
+	}
+
 	// KamataEngineの初期化
 	KamataEngine::Initialize(L"LE2B_04_オオシマ_タイガ_奈落ランナー");
 	// DirectXCommonインスタンスの取得
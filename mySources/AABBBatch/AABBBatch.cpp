@@ -0,0 +1,170 @@
+#include "AABBBatch.h"
+#include <limits>
+#ifdef _DEBUG
+#include <chrono>
+#include <random>
+#endif // _DEBUG
+
+// x64 なら SSE2 は必ず使える（AVX は /arch:AVX を付けないと使えないので使わない）
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define AABB_BATCH_SSE2
+#endif
+
+using namespace KamataEngine::MathUtility;
+
+// ============================
+// 箱の登録
+// ============================
+
+void AABBBatch::Clear() {
+	count_ = 0;
+	minX_.clear();
+	minY_.clear();
+	minZ_.clear();
+	maxX_.clear();
+	maxY_.clear();
+	maxZ_.clear();
+}
+
+void AABBBatch::Add(const AABB& aabb) {
+
+	// 末尾の埋め草を本物の箱で上書きする
+	if (count_ < minX_.size()) {
+		minX_[count_] = aabb.min.x;
+		minY_[count_] = aabb.min.y;
+		minZ_[count_] = aabb.min.z;
+		maxX_[count_] = aabb.max.x;
+		maxY_[count_] = aabb.max.y;
+		maxZ_[count_] = aabb.max.z;
+		++count_;
+		return;
+	}
+
+	// 埋め草が無ければ kLaneCount 個分伸ばし、先頭に入れて残りは何とも当たらない箱（min = +∞, max = -∞）にする
+	const float inf = std::numeric_limits<float>::infinity();
+	const size_t size = minX_.size() + kLaneCount;
+	minX_.resize(size, inf);
+	minY_.resize(size, inf);
+	minZ_.resize(size, inf);
+	maxX_.resize(size, -inf);
+	maxY_.resize(size, -inf);
+	maxZ_.resize(size, -inf);
+	Add(aabb);
+}
+
+// ============================
+// まとめて重なり判定
+// ============================
+
+void AABBBatch::Overlap(const AABB& query, std::vector<uint64_t>& hits) const {
+
+	hits.assign((count_ + 63) / 64, 0);
+
+#if defined(AABB_BATCH_SSE2)
+
+	const __m128 queryMinX = _mm_set1_ps(query.min.x);
+	const __m128 queryMinY = _mm_set1_ps(query.min.y);
+	const __m128 queryMinZ = _mm_set1_ps(query.min.z);
+	const __m128 queryMaxX = _mm_set1_ps(query.max.x);
+	const __m128 queryMaxY = _mm_set1_ps(query.max.y);
+	const __m128 queryMaxZ = _mm_set1_ps(query.max.z);
+
+	// 4つずつ：query.min <= max かつ query.max >= min を3軸ぶん AND して、符号ビットを集める
+	for (size_t i = 0; i < count_; i += 4) {
+		__m128 mask = _mm_and_ps(_mm_cmple_ps(queryMinX, _mm_loadu_ps(&maxX_[i])), _mm_cmpge_ps(queryMaxX, _mm_loadu_ps(&minX_[i])));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmple_ps(queryMinY, _mm_loadu_ps(&maxY_[i])), _mm_cmpge_ps(queryMaxY, _mm_loadu_ps(&minY_[i]))));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmple_ps(queryMinZ, _mm_loadu_ps(&maxZ_[i])), _mm_cmpge_ps(queryMaxZ, _mm_loadu_ps(&minZ_[i]))));
+		hits[i / 64] |= static_cast<uint64_t>(_mm_movemask_ps(mask)) << (i % 64);
+	}
+
+#else
+
+	OverlapScalar(query, hits);
+
+#endif
+}
+
+void AABBBatch::OverlapScalar(const AABB& query, std::vector<uint64_t>& hits) const {
+
+	hits.assign((count_ + 63) / 64, 0);
+
+	for (size_t i = 0; i < count_; ++i) {
+		const bool overlap = (query.min.x <= maxX_[i] && query.max.x >= minX_[i]) && //
+		                     (query.min.y <= maxY_[i] && query.max.y >= minY_[i]) && //
+		                     (query.min.z <= maxZ_[i] && query.max.z >= minZ_[i]);
+		hits[i / 64] |= static_cast<uint64_t>(overlap) << (i % 64);
+	}
+}
+
+const char* AABBBatch::GetKernelName() {
+#if defined(AABB_BATCH_SSE2)
+	return "SSE2";
+#else
+	return "スカラー";
+#endif
+}
+
+#ifdef _DEBUG
+// ============================
+// ベンチマーク
+// ============================
+
+AABBBatchBenchmark RunAABBBatchBenchmark(size_t boxCount, uint32_t queryCount) {
+
+	// ステージと同じくらいの広さに、キャラクターくらいの箱をばらまく（乱数は固定）
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> positionX(0.0f, 400.0f);
+	std::uniform_real_distribution<float> positionY(0.0f, 40.0f);
+	const Vector3 halfSize = {0.9f, 0.9f, 0.9f};
+
+	AABBBatch batch;
+	for (size_t i = 0; i < boxCount; ++i) {
+		const Vector3 center = {positionX(random), positionY(random), 0.0f};
+		batch.Add({center - halfSize, center + halfSize});
+	}
+
+	std::vector<AABB> queries;
+	for (uint32_t i = 0; i < queryCount; ++i) {
+		const Vector3 center = {positionX(random), positionY(random), 0.0f};
+		queries.push_back({center - halfSize, center + halfSize});
+	}
+
+	AABBBatchBenchmark result;
+	result.boxCount = boxCount;
+	result.queryCount = queryCount;
+	result.resultsMatch = true;
+
+	std::vector<uint64_t> scalarHits;
+	std::vector<uint64_t> simdHits;
+	uint64_t scalarSum = 0;
+	uint64_t simdSum = 0;
+
+	const auto scalarBegin = std::chrono::steady_clock::now();
+	for (const AABB& query : queries) {
+		batch.OverlapScalar(query, scalarHits);
+		scalarSum += scalarHits.empty() ? 0 : scalarHits[0];
+	}
+	const auto simdBegin = std::chrono::steady_clock::now();
+	for (const AABB& query : queries) {
+		batch.Overlap(query, simdHits);
+		simdSum += simdHits.empty() ? 0 : simdHits[0];
+	}
+	const auto simdEnd = std::chrono::steady_clock::now();
+
+	// 最適化で消されないよう結果を使い、ついでに全ビットが一致するかも確かめる
+	for (const AABB& query : queries) {
+		batch.OverlapScalar(query, scalarHits);
+		batch.Overlap(query, simdHits);
+		result.resultsMatch = result.resultsMatch && scalarHits == simdHits;
+	}
+	result.resultsMatch = result.resultsMatch && scalarSum == simdSum;
+
+	const double boxTests = static_cast<double>(boxCount) * queryCount;
+	if (boxTests > 0.0) {
+		result.scalarNanosecondsPerBox = std::chrono::duration<double, std::nano>(simdBegin - scalarBegin).count() / boxTests;
+		result.simdNanosecondsPerBox = std::chrono::duration<double, std::nano>(simdEnd - simdBegin).count() / boxTests;
+	}
+	return result;
+}
+#endif // _DEBUG
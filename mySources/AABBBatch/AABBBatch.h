@@ -0,0 +1,64 @@
+#pragma once
+#include "../struct.h"
+#include <KamataEngine.h>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// 同じ種類の当たり判定の箱を成分ごとの配列（SoA）で持ち、1つの箱とまとめて重なりを調べる
+// 判定は AABB::CheckCollision と同じ（境界で接していても当たり）
+class AABBBatch {
+public:
+	void Clear();
+
+	// 追加した順に 0, 1, 2, ... の番号になる
+	void Add(const AABB& aabb);
+
+	size_t Size() const { return count_; }
+
+	// query と重なる箱の番号のビットを立てる（番号 i は hits[i / 64] の i % 64 ビット目）
+	// SSE2 が使えれば4つずつまとめて比較する
+	void Overlap(const AABB& query, std::vector<uint64_t>& hits) const;
+	// 同じ結果を1つずつ比較して求める（SIMD が使えない環境用・比較用）
+	void OverlapScalar(const AABB& query, std::vector<uint64_t>& hits) const;
+
+	// Overlap で使われる命令セットの名前
+	static const char* GetKernelName();
+
+	// 立っているビットの番号を小さい順に渡す
+	template <typename Func> static void ForEachHit(const std::vector<uint64_t>& hits, Func&& func) {
+		for (size_t word = 0; word < hits.size(); ++word) {
+			for (uint64_t bits = hits[word]; bits != 0; bits &= bits - 1) {
+				func(static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+			}
+		}
+	}
+
+private:
+	// 一度に比較する箱の数（SSE2 の4つ分）。末尾は当たらない箱で埋めて端数処理をなくす
+	static inline const size_t kLaneCount = 4;
+
+	size_t count_ = 0;
+
+	std::vector<float> minX_;
+	std::vector<float> minY_;
+	std::vector<float> minZ_;
+	std::vector<float> maxX_;
+	std::vector<float> maxY_;
+	std::vector<float> maxZ_;
+};
+
+#ifdef _DEBUG
+// Overlap と OverlapScalar の速さを比べる（デバッグ表示用）
+struct AABBBatchBenchmark {
+	size_t boxCount = 0;
+	uint32_t queryCount = 0;
+	double scalarNanosecondsPerBox = 0.0;
+	double simdNanosecondsPerBox = 0.0;
+	bool resultsMatch = false; // 両方の結果が一致したか
+};
+
+AABBBatchBenchmark RunAABBBatchBenchmark(size_t boxCount, uint32_t queryCount);
+#endif // _DEBUG
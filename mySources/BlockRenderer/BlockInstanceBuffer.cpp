@@ -0,0 +1,42 @@
+#include "BlockInstanceBuffer.h"
+#include "MapChipField/MapChipField.h"
+#include <algorithm>
+
+void BlockInstanceBuffer::Build(const MapChipField& mapChipField, uint32_t chunkIndex) {
+
+	Clear();
+	chunkIndex_ = chunkIndex;
+
+	const uint32_t numBlockHorizontal = mapChipField.GetNumBlockHorizontal();
+	const uint32_t numBlockVirtical = mapChipField.GetNumBlockVirtical();
+	const uint32_t chunkWidth = MapChipField::GetChunkWidth();
+	const uint32_t xBegin = chunkIndex * chunkWidth;
+	const uint32_t xEnd = (std::min)(xBegin + chunkWidth, numBlockHorizontal);
+	if (xBegin >= xEnd) {
+		return;
+	}
+
+	rowOffsets_.reserve(static_cast<size_t>(numBlockVirtical) + 1);
+	rowOffsets_.push_back(0);
+	for (uint32_t i = 0; i < numBlockVirtical; ++i) {
+		for (uint32_t j = xBegin; j < xEnd; ++j) {
+			if (mapChipField.IsSolid(j, i)) {
+				instances_.push_back({mapChipField.GetMapChipPositionByIndex(j, i)});
+			}
+		}
+		rowOffsets_.push_back(static_cast<uint32_t>(instances_.size()));
+	}
+}
+
+void BlockInstanceBuffer::Clear() {
+	chunkIndex_ = 0;
+	instances_.clear();
+	rowOffsets_.clear();
+}
+
+std::pair<uint32_t, uint32_t> BlockInstanceBuffer::GetRowRange(uint32_t yIndex) const {
+	if (static_cast<size_t>(yIndex) + 1 >= rowOffsets_.size()) {
+		return {0, 0};
+	}
+	return {rowOffsets_[yIndex], rowOffsets_[yIndex + 1]};
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace KamataEngine;
+
+class MapChipField;
+
+// ブロック1つ分のインスタンスデータ
+// 16 バイト単位の並びにしておき、そのまま GPU の StructuredBuffer に置けるようにする
+struct BlockInstance {
+	Vector3 position;
+	float padding = 0.0f;
+};
+
+// チャンク1つ（kChunkWidth 列）のブロックの位置を、行ごとに連続した1本の配列にまとめる
+// チャンクの読み込みスレッドで作り、読み込まれている間だけ持つ（ステージ全体の配列は作らない）
+// GPU を使わないので、マップさえあれば単体で動かして確かめられる
+class BlockInstanceBuffer {
+public:
+	void Build(const MapChipField& mapChipField, uint32_t chunkIndex);
+	void Clear();
+
+	uint32_t GetChunkIndex() const { return chunkIndex_; }
+	// 並びは行ごとに左から
+	const std::vector<BlockInstance>& GetInstances() const { return instances_; }
+	// yIndex 行のブロックの範囲 [first, second)（GetInstances の添字）
+	std::pair<uint32_t, uint32_t> GetRowRange(uint32_t yIndex) const;
+
+	size_t GetByteSize() const { return instances_.size() * sizeof(BlockInstance); }
+
+private:
+	uint32_t chunkIndex_ = 0;
+	std::vector<BlockInstance> instances_;
+	// y 行のブロックは instances_[rowOffsets_[y], rowOffsets_[y + 1])
+	std::vector<uint32_t> rowOffsets_;
+};
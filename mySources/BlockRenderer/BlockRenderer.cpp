@@ -0,0 +1,294 @@
+#include "BlockRenderer.h"
+#include "BlockRenderer/StaticMapMesh.h"
+#include "FastMath/FastMath.h"
+#include "MapChipField/MapChipField.h"
+#include <Windows.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <d3dcompiler.h>
+#include <string>
+
+using Microsoft::WRL::ComPtr;
+
+namespace {
+
+// 描画先はエンジンのバックバッファと深度バッファ（Model のパイプラインと同じ形式）
+const DXGI_FORMAT kRenderTargetFormat = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+const DXGI_FORMAT kDepthStencilFormat = DXGI_FORMAT_D32_FLOAT;
+
+// Resources/shaders の HLSL をコンパイルする（失敗したらエラー内容を出力ウィンドウに出して止める）
+ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath, const char* target) {
+
+	UINT flags = 0;
+#ifdef _DEBUG
+	flags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif // _DEBUG
+
+	ComPtr<ID3DBlob> blob;
+	ComPtr<ID3DBlob> errorBlob;
+	const HRESULT result = D3DCompileFromFile(filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target, flags, 0, &blob, &errorBlob);
+	if (FAILED(result)) {
+		if (errorBlob) {
+			OutputDebugStringA(std::string(static_cast<const char*>(errorBlob->GetBufferPointer()), errorBlob->GetBufferSize()).c_str());
+		}
+		assert(false);
+	}
+	return blob;
+}
+
+// CPU から書き込む UPLOAD ヒープのバッファ
+ComPtr<ID3D12Resource> CreateUploadBuffer(ID3D12Device* device, UINT64 size) {
+
+	D3D12_HEAP_PROPERTIES heapProperties = {};
+	heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+	D3D12_RESOURCE_DESC desc = {};
+	desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+	desc.Width = size;
+	desc.Height = 1;
+	desc.DepthOrArraySize = 1;
+	desc.MipLevels = 1;
+	desc.SampleDesc.Count = 1;
+	desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+	ComPtr<ID3D12Resource> buffer;
+	[[maybe_unused]] const HRESULT result =
+	    device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer));
+	assert(SUCCEEDED(result));
+	return buffer;
+}
+
+} // namespace
+
+// ============================
+// 初期化
+// ============================
+
+void BlockRenderer::Initialize(uint32_t textureHandle) {
+
+	textureHandle_ = textureHandle;
+
+	CreatePipeline();
+	CreateBlockMesh();
+
+	// 定数バッファは 256 バイト単位
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	cameraBuffer_ = CreateUploadBuffer(device, (sizeof(CameraConstants) + 0xff) & ~UINT64{0xff});
+	cameraBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&cameraData_));
+
+	ReserveInstances(kInitialInstanceCapacity);
+}
+
+void BlockRenderer::CreatePipeline() {
+
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	// ルートシグネチャ
+	// インスタンスは StructuredBuffer なので、ディスクリプタヒープを使わずルートに直接アドレスを置ける
+	D3D12_DESCRIPTOR_RANGE textureRange = {};
+	textureRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+	textureRange.NumDescriptors = 1;
+	textureRange.BaseShaderRegister = 0; // t0
+	textureRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+	D3D12_ROOT_PARAMETER rootParameters[kRootParameterCount] = {};
+	rootParameters[kRootCamera].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+	rootParameters[kRootCamera].Descriptor.ShaderRegister = 0; // b0
+	rootParameters[kRootCamera].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	rootParameters[kRootInstances].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+	rootParameters[kRootInstances].Descriptor.ShaderRegister = 1; // t1
+	rootParameters[kRootInstances].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+	rootParameters[kRootTexture].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	rootParameters[kRootTexture].DescriptorTable.NumDescriptorRanges = 1;
+	rootParameters[kRootTexture].DescriptorTable.pDescriptorRanges = &textureRange;
+	rootParameters[kRootTexture].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+	D3D12_STATIC_SAMPLER_DESC sampler = {};
+	sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+	sampler.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	sampler.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	sampler.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+	sampler.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+	sampler.MaxLOD = D3D12_FLOAT32_MAX;
+	sampler.ShaderRegister = 0; // s0
+	sampler.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
+	rootSignatureDesc.NumParameters = kRootParameterCount;
+	rootSignatureDesc.pParameters = rootParameters;
+	rootSignatureDesc.NumStaticSamplers = 1;
+	rootSignatureDesc.pStaticSamplers = &sampler;
+	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+
+	ComPtr<ID3DBlob> rootSignatureBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3D12SerializeRootSignature(&rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &rootSignatureBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	result = device->CreateRootSignature(0, rootSignatureBlob->GetBufferPointer(), rootSignatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	// 頂点は StaticMapMesh と同じ MapMeshVertex（位置・法線・UV）
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	const ComPtr<ID3DBlob> vsBlob = CompileShader(L"Resources/shaders/BlockVS.hlsl", "vs_5_0");
+	const ComPtr<ID3DBlob> psBlob = CompileShader(L"Resources/shaders/BlockPS.hlsl", "ps_5_0");
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc = {};
+	pipelineDesc.pRootSignature = rootSignature_.Get();
+	pipelineDesc.VS = {vsBlob->GetBufferPointer(), vsBlob->GetBufferSize()};
+	pipelineDesc.PS = {psBlob->GetBufferPointer(), psBlob->GetBufferSize()};
+	pipelineDesc.InputLayout = {inputLayout, _countof(inputLayout)};
+	pipelineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	pipelineDesc.SampleDesc.Count = 1;
+
+	// ブロックは不透明なので混ぜない。面は外から見て時計回りが表
+	pipelineDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	pipelineDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+	pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_BACK;
+	pipelineDesc.RasterizerState.DepthClipEnable = TRUE;
+	pipelineDesc.DepthStencilState.DepthEnable = TRUE;
+	pipelineDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ALL;
+	pipelineDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_LESS;
+
+	pipelineDesc.NumRenderTargets = 1;
+	pipelineDesc.RTVFormats[0] = kRenderTargetFormat;
+	pipelineDesc.DSVFormat = kDepthStencilFormat;
+
+	result = device->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pipelineState_));
+	assert(SUCCEEDED(result));
+}
+
+void BlockRenderer::CreateBlockMesh() {
+
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+	const MapChunkMesh mesh = StaticMapMesh::MakeBlockMesh();
+
+	// 24 頂点・36 インデックスしかないので、アップロードヒープに置いたまま使う
+	const UINT vertexBytes = static_cast<UINT>(mesh.vertices.size() * sizeof(MapMeshVertex));
+	vertexBuffer_ = CreateUploadBuffer(device, vertexBytes);
+	void* vertexData = nullptr;
+	vertexBuffer_->Map(0, nullptr, &vertexData);
+	std::memcpy(vertexData, mesh.vertices.data(), vertexBytes);
+	vertexBuffer_->Unmap(0, nullptr);
+	vertexBufferView_.BufferLocation = vertexBuffer_->GetGPUVirtualAddress();
+	vertexBufferView_.SizeInBytes = vertexBytes;
+	vertexBufferView_.StrideInBytes = sizeof(MapMeshVertex);
+
+	const UINT indexBytes = static_cast<UINT>(mesh.indices.size() * sizeof(uint32_t));
+	indexBuffer_ = CreateUploadBuffer(device, indexBytes);
+	void* indexData = nullptr;
+	indexBuffer_->Map(0, nullptr, &indexData);
+	std::memcpy(indexData, mesh.indices.data(), indexBytes);
+	indexBuffer_->Unmap(0, nullptr);
+	indexBufferView_.BufferLocation = indexBuffer_->GetGPUVirtualAddress();
+	indexBufferView_.SizeInBytes = indexBytes;
+	indexBufferView_.Format = DXGI_FORMAT_R32_UINT;
+
+	indexCount_ = static_cast<uint32_t>(mesh.indices.size());
+}
+
+void BlockRenderer::ReserveInstances(uint32_t count) {
+
+	if (count <= instanceCapacity_) {
+		return;
+	}
+
+	// エンジンは毎フレーム GPU の完了を待つので、前のフレームで使ったバッファはここで手放してよい
+	instanceCapacity_ = (std::max)(count, instanceCapacity_ * 2);
+	instanceBuffer_ = CreateUploadBuffer(DirectXCommon::GetInstance()->GetDevice(), static_cast<UINT64>(instanceCapacity_) * sizeof(BlockInstance));
+	instanceBuffer_->Map(0, nullptr, reinterpret_cast<void**>(&instanceData_));
+}
+
+// ============================
+// 描画
+// ============================
+
+void BlockRenderer::Draw(const MapChipField& mapChipField, const Camera& camera, const Rect& visibleRegion) {
+
+	drawCallCount_ = 0;
+	drawnCount_ = 0;
+	culledCount_ = 0;
+	if (!pipelineState_) {
+		return;
+	}
+
+	const std::vector<MapChipField::BlockChunk>& chunks = mapChipField.GetResidentBlockChunks();
+	uint32_t residentCount = 0;
+	for (const MapChipField::BlockChunk& chunk : chunks) {
+		residentCount += static_cast<uint32_t>(chunk.instances.GetInstances().size());
+	}
+
+	// 見えている範囲をタイルの添字の範囲にする（行は上が 0）
+	const int64_t numBlockHorizontal = mapChipField.GetNumBlockHorizontal();
+	const int64_t numBlockVirtical = mapChipField.GetNumBlockVirtical();
+	const float blockWidth = MapChipField::GetBlockWidth();
+	const float blockHeight = MapChipField::GetBlockHeight();
+	const int64_t xMin = (std::max)(static_cast<int64_t>(std::floor((visibleRegion.left + blockWidth / 2.0f) / blockWidth)), int64_t{0});
+	const int64_t xMax = (std::min)(static_cast<int64_t>(std::floor((visibleRegion.right + blockWidth / 2.0f) / blockWidth)), numBlockHorizontal - 1);
+	const int64_t yMin = (std::max)(numBlockVirtical - 1 - static_cast<int64_t>(std::floor((visibleRegion.top + blockHeight / 2.0f) / blockHeight)), int64_t{0});
+	const int64_t yMax = (std::min)(numBlockVirtical - 1 - static_cast<int64_t>(std::floor((visibleRegion.bottom + blockHeight / 2.0f) / blockHeight)), numBlockVirtical - 1);
+	if (xMin > xMax || yMin > yMax) {
+		culledCount_ = residentCount;
+		return;
+	}
+
+	// 見えている行だけをたどり、行の中（左から並んでいる）は列の範囲を二分探索で切り出す
+	const float leftX = static_cast<float>(xMin) * blockWidth - blockWidth / 2.0f;
+	const float rightX = static_cast<float>(xMax) * blockWidth + blockWidth / 2.0f;
+	const int64_t chunkWidth = MapChipField::GetChunkWidth();
+	visibleRuns_.clear();
+	for (const MapChipField::BlockChunk& chunk : chunks) {
+		const int64_t chunkLeft = chunk.chunkIndex * chunkWidth;
+		if (chunkLeft > xMax || chunkLeft + chunkWidth - 1 < xMin) {
+			continue;
+		}
+		const std::vector<BlockInstance>& instances = chunk.instances.GetInstances();
+		for (int64_t yIndex = yMin; yIndex <= yMax; ++yIndex) {
+			const auto [first, last] = chunk.instances.GetRowRange(static_cast<uint32_t>(yIndex));
+			const auto begin = std::lower_bound(instances.begin() + first, instances.begin() + last, leftX, [](const BlockInstance& instance, float x) { return instance.position.x < x; });
+			const auto end = std::upper_bound(begin, instances.begin() + last, rightX, [](float x, const BlockInstance& instance) { return x < instance.position.x; });
+			if (begin != end) {
+				visibleRuns_.emplace_back(&*begin, static_cast<size_t>(end - begin));
+				drawnCount_ += static_cast<uint32_t>(end - begin);
+			}
+		}
+	}
+	culledCount_ = residentCount - drawnCount_;
+	if (drawnCount_ == 0) {
+		return;
+	}
+
+	// 見えている分をインスタンスバッファへ詰め、カメラの行列と一緒に送る
+	// エンジンは毎フレーム GPU の完了を待つので、前のフレームの内容はそのまま上書きしてよい
+	ReserveInstances(drawnCount_);
+	BlockInstance* destination = instanceData_;
+	for (std::span<const BlockInstance> run : visibleRuns_) {
+		std::memcpy(destination, run.data(), run.size_bytes());
+		destination += run.size();
+	}
+	cameraData_->viewProjection = FastMath::Multiply(camera.matView, camera.matProjection);
+
+	// Model::PreDraw で設定されたパイプラインを自前のものに差し替えて描き、終わったら戻す
+	ID3D12GraphicsCommandList* commandList = DirectXCommon::GetInstance()->GetCommandList();
+	Model::PostDraw();
+
+	commandList->SetGraphicsRootSignature(rootSignature_.Get());
+	commandList->SetPipelineState(pipelineState_.Get());
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
+	commandList->IASetIndexBuffer(&indexBufferView_);
+	commandList->SetGraphicsRootConstantBufferView(kRootCamera, cameraBuffer_->GetGPUVirtualAddress());
+	commandList->SetGraphicsRootShaderResourceView(kRootInstances, instanceBuffer_->GetGPUVirtualAddress());
+	TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(commandList, kRootTexture, textureHandle_);
+	commandList->DrawIndexedInstanced(indexCount_, drawnCount_, 0, 0, 0);
+	++drawCallCount_;
+
+	Model::PreDraw(commandList);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "BlockRenderer/BlockInstanceBuffer.h"
+#include "CameraController/CameraController.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <d3d12.h>
+#include <span>
+#include <vector>
+#include <wrl.h>
+
+using namespace KamataEngine;
+
+class MapChipField;
+
+// マップのブロックの描画をまとめて受け持つ
+// 読み込まれているチャンクのうち見えているブロックの位置をアップロードバッファに詰め、
+// 立方体1つを DrawIndexedInstanced 1回でその数だけ描く（位置は頂点シェーダーが StructuredBuffer から引く）
+// Model にはインスタンス描画の入口が無いので、ルートシグネチャとパイプラインはここで自前で持つ
+class BlockRenderer {
+public:
+	void Initialize(uint32_t textureHandle);
+
+	// visibleRegion（XY）に重なるタイルの範囲だけを描く。Model::PreDraw ～ PostDraw の間で、1フレームに1回呼ぶ
+	void Draw(const MapChipField& mapChipField, const Camera& camera, const Rect& visibleRegion);
+
+	// 直前の Draw の描画呼び出し数・描いたブロック数・読み込み済みだが見えていないので描かなかった数（デバッグ表示用）
+	uint32_t GetDrawCallCount() const { return drawCallCount_; }
+	uint32_t GetDrawnCount() const { return drawnCount_; }
+	uint32_t GetCulledCount() const { return culledCount_; }
+	// 直前の Draw で GPU へ送ったインスタンスの大きさ
+	size_t GetUploadedBytes() const { return static_cast<size_t>(drawnCount_) * sizeof(BlockInstance); }
+
+private:
+	// ルートパラメータの並び
+	enum RootParameter : uint32_t {
+		kRootCamera,    // b0 : BlockCamera
+		kRootInstances, // t1 : StructuredBuffer<BlockInstance>（ルートに直接置く）
+		kRootTexture,   // t0 : テクスチャ（TextureManager のディスクリプタ）
+		kRootParameterCount,
+	};
+
+	// 定数バッファ（Block.hlsli の BlockCamera と同じ並び）
+	struct CameraConstants {
+		Matrix4x4 viewProjection;
+	};
+
+	// インスタンスバッファを最初に確保する数（足りなければ倍々に伸ばす）
+	static inline const uint32_t kInitialInstanceCapacity = 1024;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState_;
+
+	// ブロック1つ分の立方体
+	Microsoft::WRL::ComPtr<ID3D12Resource> vertexBuffer_;
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuffer_;
+	D3D12_VERTEX_BUFFER_VIEW vertexBufferView_ = {};
+	D3D12_INDEX_BUFFER_VIEW indexBufferView_ = {};
+	uint32_t indexCount_ = 0;
+
+	// 毎フレーム書き換えるもの（マップしたまま持つ）
+	Microsoft::WRL::ComPtr<ID3D12Resource> cameraBuffer_;
+	CameraConstants* cameraData_ = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12Resource> instanceBuffer_;
+	BlockInstance* instanceData_ = nullptr;
+	uint32_t instanceCapacity_ = 0;
+
+	uint32_t textureHandle_ = 0;
+
+	// 見えている範囲のインスタンス（行ごとに連続した並びをそのまま指す）
+	std::vector<std::span<const BlockInstance>> visibleRuns_;
+
+	uint32_t drawCallCount_ = 0;
+	uint32_t drawnCount_ = 0;
+	uint32_t culledCount_ = 0;
+
+	void CreatePipeline();
+	void CreateBlockMesh();
+	// インスタンスバッファを count 個以上にする（描画コマンドを積む前に呼ぶ）
+	void ReserveInstances(uint32_t count);
+};
@@ -0,0 +1,185 @@
+#include "StaticMapMesh.h"
+#include "MapChipField/MapChipField.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+// ブロックの面1枚（外から見て 左上・右上・右下・左下 の順の角。±1 はブロックの中心からの向き）
+struct CubeFace {
+	Vector3 normal;
+	std::array<Vector3, 4> corners;
+	int32_t dx; // 隣のタイルへの向き（前後の面は 0, 0）
+	int32_t dy; // 行の添字の向き（上が -1）
+};
+
+// Model::Create() の立方体と同じく、中心から ±1（ブロック1つ分）の箱
+const std::array<CubeFace, 6> kCubeFaces = {{
+    // 手前（-Z、カメラ側）
+    {{0.0f, 0.0f, -1.0f}, {{{-1.0f, 1.0f, -1.0f}, {1.0f, 1.0f, -1.0f}, {1.0f, -1.0f, -1.0f}, {-1.0f, -1.0f, -1.0f}}}, 0, 0},
+    // 奥（+Z）
+    {{0.0f, 0.0f, 1.0f}, {{{1.0f, 1.0f, 1.0f}, {-1.0f, 1.0f, 1.0f}, {-1.0f, -1.0f, 1.0f}, {1.0f, -1.0f, 1.0f}}}, 0, 0},
+    // 右（+X）
+    {{1.0f, 0.0f, 0.0f}, {{{1.0f, 1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, -1.0f, 1.0f}, {1.0f, -1.0f, -1.0f}}}, 1, 0},
+    // 左（-X）
+    {{-1.0f, 0.0f, 0.0f}, {{{-1.0f, 1.0f, 1.0f}, {-1.0f, 1.0f, -1.0f}, {-1.0f, -1.0f, -1.0f}, {-1.0f, -1.0f, 1.0f}}}, -1, 0},
+    // 上（+Y）
+    {{0.0f, 1.0f, 0.0f}, {{{-1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {1.0f, 1.0f, -1.0f}, {-1.0f, 1.0f, -1.0f}}}, 0, -1},
+    // 下（-Y）
+    {{0.0f, -1.0f, 0.0f}, {{{1.0f, -1.0f, 1.0f}, {-1.0f, -1.0f, 1.0f}, {-1.0f, -1.0f, -1.0f}, {1.0f, -1.0f, -1.0f}}}, 0, 1},
+}};
+
+const std::array<Vector2, 4> kFaceTexcoords = {{{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}};
+
+} // namespace
+
+void StaticMapMesh::Bake(const MapChipField& mapChipField) {
+
+	Clear();
+
+	const uint32_t numChunks = mapChipField.GetNumChunks();
+	const uint32_t numBlockHorizontal = mapChipField.GetNumBlockHorizontal();
+	const uint32_t numBlockVirtical = mapChipField.GetNumBlockVirtical();
+	const uint32_t chunkWidth = MapChipField::GetChunkWidth();
+	const float halfWidth = MapChipField::GetBlockWidth() / 2.0f;
+	const float halfHeight = MapChipField::GetBlockHeight() / 2.0f;
+	// 奥行きはブロックの幅と同じ
+	const float halfDepth = halfWidth;
+
+	// マップの外は空いているものとする（端の面は残す）
+	const auto isSolid = [&](int64_t xIndex, int64_t yIndex) {
+		if (xIndex < 0 || yIndex < 0 || xIndex >= numBlockHorizontal || yIndex >= numBlockVirtical) {
+			return false;
+		}
+		return mapChipField.IsSolid(static_cast<uint32_t>(xIndex), static_cast<uint32_t>(yIndex));
+	};
+
+	chunkMeshes_.resize(numChunks);
+	for (uint32_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+		MapChunkMesh& mesh = chunkMeshes_[chunkIndex];
+		mesh.chunkIndex = chunkIndex;
+
+		const uint32_t xBegin = chunkIndex * chunkWidth;
+		const uint32_t xEnd = (std::min)(xBegin + chunkWidth, numBlockHorizontal);
+
+		for (uint32_t i = 0; i < numBlockVirtical; ++i) {
+			for (uint32_t j = xBegin; j < xEnd; ++j) {
+				if (!mapChipField.IsSolid(j, i)) {
+					continue;
+				}
+				const Vector3 center = mapChipField.GetMapChipPositionByIndex(j, i);
+
+				for (const CubeFace& face : kCubeFaces) {
+					// 隣もブロックなら、その間の面は見えない
+					if ((face.dx != 0 || face.dy != 0) && isSolid(static_cast<int64_t>(j) + face.dx, static_cast<int64_t>(i) + face.dy)) {
+						++removedFaceCount_;
+						continue;
+					}
+
+					const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+					for (size_t corner = 0; corner < 4; ++corner) {
+						MapMeshVertex vertex;
+						vertex.position = {
+						    center.x + face.corners[corner].x * halfWidth,
+						    center.y + face.corners[corner].y * halfHeight,
+						    center.z + face.corners[corner].z * halfDepth,
+						};
+						vertex.normal = face.normal;
+						vertex.texcoord = kFaceTexcoords[corner];
+						mesh.vertices.push_back(vertex);
+					}
+					// 左上・右上・右下 と 左上・右下・左下 の2枚（外から見て時計回り）
+					mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+				}
+			}
+		}
+	}
+}
+
+MapChunkMesh StaticMapMesh::MakeBlockMesh() {
+
+	const float halfWidth = MapChipField::GetBlockWidth() / 2.0f;
+	const float halfHeight = MapChipField::GetBlockHeight() / 2.0f;
+	const float halfDepth = halfWidth;
+
+	MapChunkMesh mesh;
+	for (const CubeFace& face : kCubeFaces) {
+		const uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+		for (size_t corner = 0; corner < 4; ++corner) {
+			MapMeshVertex vertex;
+			vertex.position = {face.corners[corner].x * halfWidth, face.corners[corner].y * halfHeight, face.corners[corner].z * halfDepth};
+			vertex.normal = face.normal;
+			vertex.texcoord = kFaceTexcoords[corner];
+			mesh.vertices.push_back(vertex);
+		}
+		mesh.indices.insert(mesh.indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+	}
+	return mesh;
+}
+
+void StaticMapMesh::Clear() {
+	chunkMeshes_.clear();
+	removedFaceCount_ = 0;
+}
+
+size_t StaticMapMesh::GetVertexCount() const {
+	size_t count = 0;
+	for (const MapChunkMesh& mesh : chunkMeshes_) {
+		count += mesh.vertices.size();
+	}
+	return count;
+}
+
+size_t StaticMapMesh::GetTriangleCount() const {
+	size_t count = 0;
+	for (const MapChunkMesh& mesh : chunkMeshes_) {
+		count += mesh.indices.size() / 3;
+	}
+	return count;
+}
+
+#ifdef _DEBUG
+// ============================
+// 同梱ステージでの確認
+// ============================
+
+StaticMapMeshCheck RunStaticMapMeshCheck(const std::string& csvDirectory) {
+
+	// 面の数は stage ごとに数えた値（頂点は面 × 4、三角形は面 × 2）
+	struct Expected {
+		size_t vertexCount;
+		size_t triangleCount;
+		size_t removedFaceCount;
+	};
+	static const std::array<Expected, StaticMapMeshCheck::kStageCount> kExpected = {{
+	    {5040, 2520, 612},
+	    {4200, 2100, 480},
+	    {4928, 2464, 592},
+	    {5064, 2532, 612},
+	    {4560, 2280, 510},
+	    {4184, 2092, 460},
+	}};
+
+	StaticMapMeshCheck result;
+	result.checked = true;
+	result.allMatch = true;
+
+	MapChipField mapChipField;
+	StaticMapMesh mesh;
+	for (uint32_t i = 0; i < StaticMapMeshCheck::kStageCount; ++i) {
+		StaticMapMeshCheck::Stage& stage = result.stages[i];
+		// .stage を書き出さないよう CSV を直接読む
+		stage.loaded = mapChipField.LoadMapChipCSV(csvDirectory + "/stage" + std::to_string(i + 1) + ".csv");
+		if (stage.loaded) {
+			mesh.Bake(mapChipField);
+			stage.vertexCount = mesh.GetVertexCount();
+			stage.triangleCount = mesh.GetTriangleCount();
+			stage.removedFaceCount = mesh.GetRemovedFaceCount();
+		}
+		const Expected& expected = kExpected[i];
+		stage.match = stage.loaded && stage.vertexCount == expected.vertexCount && stage.triangleCount == expected.triangleCount && stage.removedFaceCount == expected.removedFaceCount;
+		result.allMatch = result.allMatch && stage.match;
+	}
+	return result;
+}
+#endif // _DEBUG
@@ -0,0 +1,71 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+class MapChipField;
+
+// 焼いたメッシュの頂点（位置・法線・UV）
+struct MapMeshVertex {
+	Vector3 position;
+	Vector3 normal;
+	Vector2 texcoord;
+};
+
+// チャンク1つ分の、ブロックをまとめた頂点・インデックス（三角形リスト、表は時計回り）
+struct MapChunkMesh {
+	uint32_t chunkIndex = 0;
+	std::vector<MapMeshVertex> vertices;
+	std::vector<uint32_t> indices;
+};
+
+// マップのブロックを、列方向のチャンクごとに1つのメッシュへ焼く
+// 隣もブロックの面（ブロック同士の間に挟まって見えない面）は作らない。チャンクの境目も隣のチャンクを見て判定する
+// GPU は使わないので、マップさえあれば単体で動かして確かめられる
+// 焼くのはデータだけで、このメッシュは描画しない（ブロックは BlockRenderer がインスタンス描画で描き、ここからは MakeBlockMesh の立方体だけを使う）
+// Bake はデバッグ画面から焼いて数を確かめるためのもの
+class StaticMapMesh {
+public:
+	void Bake(const MapChipField& mapChipField);
+	void Clear();
+
+	// ブロック1つ分（中心が原点）の6面すべての立方体。BlockRenderer がインスタンス描画の元の形に使う
+	static MapChunkMesh MakeBlockMesh();
+
+	const std::vector<MapChunkMesh>& GetChunkMeshes() const { return chunkMeshes_; }
+
+	size_t GetVertexCount() const;
+	size_t GetTriangleCount() const;
+	// 隣がブロックなので作らなかった面の数
+	size_t GetRemovedFaceCount() const { return removedFaceCount_; }
+
+private:
+	std::vector<MapChunkMesh> chunkMeshes_;
+	size_t removedFaceCount_ = 0;
+};
+
+#ifdef _DEBUG
+// 同梱の stage1～6 を焼き、頂点・三角形・削った面の数が想定どおりか確かめる（デバッグ表示用）
+struct StaticMapMeshCheck {
+	static inline const uint32_t kStageCount = 6;
+
+	struct Stage {
+		bool loaded = false;
+		bool match = false;
+		size_t vertexCount = 0;
+		size_t triangleCount = 0;
+		size_t removedFaceCount = 0;
+	};
+	std::array<Stage, kStageCount> stages;
+	bool checked = false; // 一度でも実行したか
+	bool allMatch = false;
+};
+
+// csvDirectory の stage1.csv～stage6.csv を読み込んで焼く
+StaticMapMeshCheck RunStaticMapMeshCheck(const std::string& csvDirectory);
+#endif // _DEBUG
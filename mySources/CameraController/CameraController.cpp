@@ -1,21 +1,17 @@
 #include "CameraController.h"
 #include "Player/Player.h"
 #include <algorithm>
-
-void CameraController::Initialize() {
-
-	camera_->Initialize();
-
-};
+#include <cmath>
 
 void CameraController::Update() {
-	// 追従対象のワールド変換を取得
-	const WorldTransform& targetWorldTransform = target_->GetWorldTransform();
 	// 追従対象とオフセットと追従対象の速度からカメラの目標位置を計算
-	targetPosition_ = targetWorldTransform.translation_ + targetOffset_ + target_->GetVelocity() * kVelocityBias;
+	// 描画と揃えるため、追従対象は補間済みの表示位置を使う
+	targetPosition_ = target_->GetInterpolatedPosition() + targetOffset_ + target_->GetVelocity() * kVelocityBias;
 
 	// 座標補間によりゆったりとカメラを追従させる
-	camera_->translation_ = lerp(camera_->translation_, targetPosition_, kInterpolationRate);
+	// 60FPSで毎フレーム kInterpolationRate だけ寄せるのと同じ追従になるよう、経過時間から率を求める
+	const float rate = 1.0f - std::pow(1.0f - kInterpolationRate, deltaTime_ / kInterpolationReferenceTime);
+	camera_->translation_ = lerp(camera_->translation_, targetPosition_, rate);
 
 	// 追従対象が画面外に出ないようにカメラの位置を制限
 	camera_->translation_.x = std::clamp(camera_->translation_.x, kMargin.left, kMargin.right);
@@ -1,4 +1,5 @@
 #pragma once
+#include "struct.h"
 #include <KamataEngine.h>
 
 class Player;
@@ -9,8 +10,6 @@ using namespace KamataEngine;
 inline Vector3 operator+(const Vector3& lhs, const Vector3& rhs) { return {lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z}; }
 inline Vector3 operator*(const Vector3& vec, float scalar) { return {vec.x * scalar, vec.y * scalar, vec.z * scalar}; }
 
-inline Vector3 lerp(const Vector3& a, const Vector3& b, float t) { return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t}; }
-
 struct Rect {
 	float left = 0.0f;
 	float right = 1.0f;
@@ -21,14 +20,16 @@ struct Rect {
 class CameraController {
 
 public:
-	void Initialize();
-
 	void Update();
 
 	void SetTarget(Player* target) { target_ = target; }
 
+	// 初期化済みのカメラを渡す（カメラの初期化は持ち主の GameScene が行う）
 	void SetCamera(Camera* camera) { camera_ = camera; }
 
+	// 前回の Update からの経過時間（秒）
+	void SetDeltaTime(float deltaTime) { deltaTime_ = deltaTime; }
+
 	void Reset();
 
 	void SetMovableArea(const Rect& area) { movableArea_ = area; }
@@ -45,7 +46,10 @@ private:
 
 	// 座標補間
 	Vector3 targetPosition_ = Vector3(0.0f, 0.0f, 0.0f);
-	static inline const float kInterpolationRate = 0.1f; // 補間率
+	static inline const float kInterpolationRate = 0.1f; // 補間率（60FPSの1フレームあたり）
+	static inline const float kInterpolationReferenceTime = 1.0f / 60.0f; // kInterpolationRate の基準時間
+
+	float deltaTime_ = 1.0f / 60.0f;
 
 	static inline const float kVelocityBias = 0.25f; // 速度のバイアス
 
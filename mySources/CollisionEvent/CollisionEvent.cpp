@@ -0,0 +1,9 @@
+#include "CollisionEvent.h"
+
+void CollisionEventQueue::Push(CollisionEvent::Type typeA, uint32_t idA, CollisionEvent::Type typeB, uint32_t idB) {
+	events_.push_back({typeA, typeB, idA, idB});
+}
+
+void CollisionEventQueue::Append(const CollisionEventQueue& other) {
+	events_.insert(events_.end(), other.events_.begin(), other.events_.end());
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 当たり判定で「何番の何と何番の何が当たったか」だけを残す記録
+// 判定側は記録を積むだけで状態を書き換えず、反応（取得・死亡・ゴールなど）は後でまとめて順番に処理する
+struct CollisionEvent {
+	enum class Type : uint8_t {
+		kPlayer,
+		kEnemy,
+		kCoin,
+		kGoal,
+	};
+
+	Type typeA;
+	Type typeB;
+	uint32_t idA; // 種類ごとの番号（判定のたびに作る一覧の添字）
+	uint32_t idB;
+};
+
+// 1ステップ分の当たり判定の記録を積んでおく入れ物（確保したメモリは次のステップで使い回す）
+class CollisionEventQueue {
+public:
+	void Clear() { events_.clear(); }
+
+	void Push(CollisionEvent::Type typeA, uint32_t idA, CollisionEvent::Type typeB, uint32_t idB);
+
+	// 別のスレッドなどで集めた記録を末尾につなぐ（つなぐ順番を決めておけば、処理の順番も毎回同じになる）
+	void Append(const CollisionEventQueue& other);
+
+	// 積んだ順に並んでいる
+	const std::vector<CollisionEvent>& GetEvents() const { return events_; }
+	size_t Size() const { return events_.size(); }
+
+private:
+	std::vector<CollisionEvent> events_;
+};
@@ -5,8 +5,8 @@ using namespace KamataEngine::MathUtility;
 
 void DeathParticles::Initialize(Camera* camera, Vector3& position) {
 
+	// カメラはシーンのものを参照するだけ（初期化はシーン側で行う）
 	camera_ = camera;
-	camera_->Initialize();
 
 	objectColor_.Initialize();
 	color_ = {1.0f, 1.0f, 1.0f, 1.0f};
@@ -74,22 +74,9 @@ void DeathParticles::Draw() {
 
 void DeathParticles::UpdateAffineTransformMatrix() {
 
-	for (WorldTransform& worldTransform : worldTransforms_) {
-
-		// スケール行列
-		Matrix4x4 scaleMat = MakeScaleMatrix(worldTransform.scale_);
-		// 回転行列
-		Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransform.rotation_.z);
-		Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransform.rotation_.y);
-		Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransform.rotation_.x);
-		Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-		// 平行移動行列
-		Matrix4x4 transMat = MakeTranslateMatrix(worldTransform.translation_);
-		// アフィン変換行列の計算
-		worldTransform.matWorld_ = scaleMat * rotMat * transMat;
-
-		// 行列を転送
-		worldTransform.TransferMatrix();
+	// 動いたパーティクルの行列だけ作り直して転送する
+	for (uint32_t i = 0; i < kNumParticles; ++i) {
+		transformCaches_[i].Update(worldTransforms_[i]);
 	}
 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "../TransformCache/TransformCache.h"
 #include <KamataEngine.h>
 #include <array>
 #include <numbers>
@@ -33,6 +34,7 @@ private:
 	static inline const uint32_t kNumParticles = 8;
 
 	std::array<WorldTransform, kNumParticles> worldTransforms_;
+	std::array<TransformCache, kNumParticles> transformCaches_;
 
 	// 存続時間
 	static inline const float kDuration = 1.0f;
@@ -1,7 +1,5 @@
 #include "Enemy.h"
-#include "MapChipField/MapChipField.h"
 #include <algorithm>
-#include <array>
 #include <cmath> // イージングで cos を使う
 #include <numbers>
 
@@ -9,13 +7,31 @@ using namespace KamataEngine::MathUtility;
 
 static float EaseInOutSine(float x) { return -(std::cos(std::numbers::pi_v<float> * x) - 1.0f) / 2.0f; }
 
-void Enemy::Initialize(Camera* camera, const Vector3& position) {
+Enemy::~Enemy() {
+	if (kinematicBodies_) {
+		kinematicBodies_->Destroy(bodyId_);
+	}
+}
+
+void Enemy::SetKinematicBodySystem(KinematicBodySystem* kinematicBodies) {
+	kinematicBodies_ = kinematicBodies;
+	bodyId_ = kinematicBodies_->Create(kWidth, kHeight, kBlank);
+}
 
-	camera_ = camera;
-	camera_->Initialize();
+void Enemy::Initialize(const Prototype& prototype, const Vector3& position) {
+
+	model_ = prototype.model;
+	camera_ = prototype.camera;
+	mapChipField_ = prototype.mapChipField;
+	deltaTime_ = prototype.deltaTime;
+	freefall_ = prototype.freefall;
+	if (prototype.kinematicBodies) {
+		SetKinematicBodySystem(prototype.kinematicBodies);
+	}
 
 	worldTransform_.Initialize();
 	worldTransform_.translation_ = position; // 初期位置
+	previousTranslation_ = position;
 
 	// 初期速度（とりあえず左向きに歩き始める）
 	velocity_ = {-kWalkSpeed, 0.0f, 0.0f};
@@ -31,6 +47,9 @@ void Enemy::Initialize(Camera* camera, const Vector3& position) {
 
 void Enemy::Update() {
 
+	// 描画の補間用にステップ開始時の位置を残す
+	previousTranslation_ = worldTransform_.translation_;
+
 	// ==== 空中なら重力を加える ====
 	if (!onGround_) {
 		velocity_ += Vector3(0.0f, -kGravityAcceleration * deltaTime_, 0.0f);
@@ -40,23 +59,22 @@ void Enemy::Update() {
 	LedgeTurnCheck();
 
 	// ==== 横移動＋落下を含む移動量を作成 ====
-	CollisionMapInfo info{};
-	info.move = velocity_ * deltaTime_;
+	// 当たり判定は全キャラクターまとめて KinematicBodySystem で行う（マップ未設定ならそのまま移動）
+	kinematicBodies_->Submit(bodyId_, worldTransform_.translation_, velocity_ * deltaTime_);
+}
 
-	if (mapChipField_) {
-		// 上下左右の順で当たり判定
-		CollisionMapCheck(info);
+void Enemy::UpdateAfterMapCollision() {
 
-		// 判定結果を反映
-		MoveByCollisionCheck(info);
+	const KinematicBody& body = kinematicBodies_->Get(bodyId_);
 
+	// 判定結果を反映
+	worldTransform_.translation_ = body.position;
+
+	if (mapChipField_) {
 		// 付随処理
-		OnCellingCollision(info); // 天井に当たったら上昇速度をゼロ
-		OnWallCollision(info);    // 壁に当たったら反転（※ここで回転開始要求を出す）
-		SwitchOnGround(info);     // 接地/空中の切り替え（落ち始め・着地）
-	} else {
-		// マップ未設定なら従来どおりそのまま移動
-		worldTransform_.translation_ += info.move;
+		OnCellingCollision(body); // 天井に当たったら上昇速度をゼロ
+		OnWallCollision(body);    // 壁に当たったら反転（※ここで回転開始要求を出す）
+		SwitchOnGround(body);     // 接地/空中の切り替え（落ち始め・着地）
 	}
 
 	// 万一、AI等で速度符号が外部から変わった場合にも対応
@@ -71,7 +89,15 @@ void Enemy::Update() {
 	// ==== イージング回転 ====
 	ModelRotate();
 
+	// 行列は描画の前に InterpolateTransform で作る（見えていない敵は作らない）
+}
+
+void Enemy::InterpolateTransform(float alpha) {
+	// 行列だけ表示位置で作り直す（シミュレーション上の位置はそのまま）
+	const Vector3 translation = worldTransform_.translation_;
+	worldTransform_.translation_ = lerp(previousTranslation_, translation, alpha);
 	UpdateAffineTransformMatrix();
+	worldTransform_.translation_ = translation;
 }
 
 void Enemy::Draw() { model_->Draw(worldTransform_, *camera_); }
@@ -79,16 +105,7 @@ void Enemy::Draw() { model_->Draw(worldTransform_, *camera_); }
 // =======================
 // アフィン変換行列の更新処理
 // =======================
-void Enemy::UpdateAffineTransformMatrix() {
-	Matrix4x4 scaleMat = MakeScaleMatrix(worldTransform_.scale_);
-	Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransform_.rotation_.z);
-	Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransform_.rotation_.y);
-	Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransform_.rotation_.x);
-	Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-	Matrix4x4 transMat = MakeTranslateMatrix(worldTransform_.translation_);
-	worldTransform_.matWorld_ = scaleMat * rotMat * transMat;
-	worldTransform_.TransferMatrix();
-}
+void Enemy::UpdateAffineTransformMatrix() { transformCache_.Update(worldTransform_); }
 
 void Enemy::OnPlayerCollision(Player* player) { player; }
 
@@ -108,155 +125,11 @@ AABB Enemy::GetAABB() {
 	return aabb;
 }
 
-// ============================
-// 角の座標を計算
-// ============================
-Vector3 Enemy::CornerPosition(const Vector3& center, Corner corner) {
-	Vector3 offsetTable[kNumCorner] = {
-	    {+kWidth / 2.0f, -kHeight / 2.0f, 0.0f}, //  右下
-	    {-kWidth / 2.0f, -kHeight / 2.0f, 0.0f}, //  左下
-	    {+kWidth / 2.0f, +kHeight / 2.0f, 0.0f}, //  右上
-	    {-kWidth / 2.0f, +kHeight / 2.0f, 0.0f}  //  左上
-	};
-	return center + offsetTable[static_cast<uint32_t>(corner)];
-}
-
-// ============================
-// 衝突判定本体（今フレームの移動量を詰める）
-// ============================
-void Enemy::CollisionMapCheck(CollisionMapInfo& info) {
-
-	// 事前に移動後の四隅を一括算出（Playerと同じ最適化）
-	std::array<Vector3, kNumCorner> positionsNew;
-	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.move, static_cast<Corner>(i));
-	}
-
-	// 上下左右の順で4回呼ぶ（Player準拠）
-	const HitDir order[] = {HitDir::kUp, HitDir::kDown, HitDir::kRight, HitDir::kLeft};
-	for (HitDir d : order) {
-		CollisionOneSide(info, d, positionsNew);
-	}
-}
-
-// ============================
-// 方向別の衝突判定（上下左右）
-// ============================
-void Enemy::CollisionOneSide(CollisionMapInfo& info, HitDir dir, const std::array<Vector3, kNumCorner>& positionsNew) {
-
-	// 方向別の早期 return 条件（Player準拠）
-	if (dir == HitDir::kUp && info.move.y <= 0.0f)
-		return; // 上昇時のみ天井判定
-	if (dir == HitDir::kDown && info.move.y >= 0.0f)
-		return; // 下降時のみ床判定
-	if (dir == HitDir::kRight && info.move.x <= 0.0f)
-		return; // 右移動時のみ右壁判定
-	if (dir == HitDir::kLeft && info.move.x >= 0.0f)
-		return; // 左移動時のみ左壁判定
-
-	bool hit = false;
-	MapChipField::IndexSet indexSet;
-	MapChipType mapChipType, mapChipTypeNext;
-
-	// 方向ごとに「見る角」「隣セル方向」を切り替える（Playerと同じ）
-	auto testTwoPoints = [&](Corner a, Corner b, int dx, int dy) {
-		// 1点目
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[static_cast<uint32_t>(a)]);
-		mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-		mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex + dx, indexSet.yIndex + dy);
-		if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock)
-			hit = true;
-
-		// 2点目
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[static_cast<uint32_t>(b)]);
-		mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-		mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex + dx, indexSet.yIndex + dy);
-		if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock)
-			hit = true;
-	};
-
-	switch (dir) {
-	case HitDir::kUp: {
-		// 左上/右上、隣セルは +y（天井）
-		testTwoPoints(kLeftTop, kRightTop, 0, +1);
-		if (!hit)
-			return;
-
-		// 「移動後の上端」基準セルを取得して rect.bottom から詰める（Playerと同式）
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + info.move + Vector3(0.0f, -kHeight / 2.0f + kBlank, 0.0f));
-		MapChipField::IndexSet now = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + Vector3(0.0f, kHeight / 2.0f + kBlank, 0.0f));
-		if (now.yIndex != indexSet.yIndex) {
-			MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-			float moveY = (rect.bottom - worldTransform_.translation_.y) - (kHeight / 2.0f + kBlank);
-			info.move.y = (std::max)(0.0f, moveY); // 上方向は正に詰める
-			info.cellingCollision = true;
-		}
-		break;
-	}
-
-	case HitDir::kDown: {
-		// 左下/右下、隣セルは -y（床）
-		testTwoPoints(kLeftBottom, kRightBottom, 0, -1);
-		if (!hit)
-			return;
-
-		// 左下のセルを起点に rect.top から詰める（Playerと同式）
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom]);
-		MapChipField::IndexSet now = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ - Vector3(0.0f, kHeight / 2.0f, 0.0f));
-		if (now.yIndex != indexSet.yIndex) {
-			MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-			float moveY = (rect.top - worldTransform_.translation_.y) + (kHeight / 2.0f + kBlank);
-			info.move.y = (std::min)(0.0f, moveY); // 下方向は負に詰める
-			info.floorCollision = true;
-		}
-		break;
-	}
-
-	case HitDir::kRight: {
-		// 右下/右上、隣セルは x-1（ブロック左端に詰める）
-		testTwoPoints(kRightBottom, kRightTop, -1, 0);
-		if (!hit)
-			return;
-
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + info.move + Vector3(kWidth / 2.0f + kBlank, 0.0f, 0.0f));
-		MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-		float moveX = (rect.left - worldTransform_.translation_.x) - (kWidth / 2.0f + kBlank);
-		info.move.x = (std::max)(0.0f, moveX);
-		info.wallCollision = true;
-		break;
-	}
-
-	case HitDir::kLeft: {
-		// 左下/左上、隣セルは x+1（ブロック右端に詰める）
-		testTwoPoints(kLeftBottom, kLeftTop, +1, 0);
-		if (!hit)
-			return;
-
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + info.move - Vector3(kWidth / 2.0f + kBlank, 0.0f, 0.0f));
-		MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-		float moveX = (rect.right - worldTransform_.translation_.x) + (kWidth / 2.0f + kBlank);
-		info.move.x = (std::min)(0.0f, moveX);
-		info.wallCollision = true;
-		break;
-	}
-
-	default:
-		break;
-	}
-}
-
-// ============================
-// 衝突判定後の移動量を適用
-// ============================
-void Enemy::MoveByCollisionCheck(const CollisionMapInfo& info) {
-	worldTransform_.translation_ += info.move; // 詰めた移動量を適用
-}
-
 // ============================
 // 天井接触時：上昇速度をゼロ
 // ============================
-void Enemy::OnCellingCollision(CollisionMapInfo& info) {
-	if (info.cellingCollision) {
+void Enemy::OnCellingCollision(const KinematicBody& body) {
+	if (body.cellingCollision) {
 		velocity_.y = 0.0f;
 	}
 }
@@ -264,8 +137,8 @@ void Enemy::OnCellingCollision(CollisionMapInfo& info) {
 // ============================
 // 壁接触時の処理：進行方向を反転（＋回転開始要求）
 // ============================
-void Enemy::OnWallCollision(CollisionMapInfo& info) {
-	if (!info.wallCollision)
+void Enemy::OnWallCollision(const KinematicBody& body) {
+	if (!body.wallCollision)
 		return;
 
 	velocity_.x *= -1.0f;    // 次フレームから逆方向へ
@@ -275,36 +148,15 @@ void Enemy::OnWallCollision(CollisionMapInfo& info) {
 // ============================
 // 接地状態の切り替え処理
 // ============================
-void Enemy::SwitchOnGround(CollisionMapInfo& info) {
+void Enemy::SwitchOnGround(const KinematicBody& body) {
 
 	if (onGround_) {
 		// 上向き速度が出たら空中へ
 		if (velocity_.y > 0.0f) {
 			onGround_ = false;
 		} else {
-			// 足元にブロックが無ければ落下開始
-			std::array<Vector3, kNumCorner> positionsNew;
-			for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-				positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.move, static_cast<Corner>(i));
-			}
-
-			bool hit = false;
-			MapChipField::IndexSet indexSet;
-			MapChipType mapChipType;
-
-			// 左下
-			indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom] + Vector3(0, -kBlank, 0));
-			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-			if (mapChipType == MapChipType::kBlock) {
-				hit = true;
-			}
-
-			// 右下
-			indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightBottom] + Vector3(0, -kBlank, 0));
-			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-			if (mapChipType == MapChipType::kBlock) {
-				hit = true;
-			}
+			// 足元にブロックが無ければ落下開始（床の有無は KinematicBodySystem が調べている）
+			const bool hit = body.groundBelow;
 
 			// 足元が空なら空中状態へ
 			if (!hit) {
@@ -314,7 +166,7 @@ void Enemy::SwitchOnGround(CollisionMapInfo& info) {
 
 	} else {
 		// 空中 → 床衝突で着地
-		if (info.floorCollision) {
+		if (body.floorCollision) {
 			onGround_ = true;
 			velocity_.x *= (1.0f - kAttenuationLanding); // 着地時の減衰
 			velocity_.y = 0.0f;                          // 落下停止
@@ -333,15 +185,15 @@ void Enemy::LedgeTurnCheck() {
 
 	// 進行方向の“下側の角”を選ぶ
 	const bool movingRight = (velocity_.x > 0.0f);
-	const Corner footCorner = movingRight ? kRightBottom : kLeftBottom;
+	const KinematicBody& body = kinematicBodies_->Get(bodyId_);
+	const KinematicBody::Corner footCorner = movingRight ? KinematicBody::kRightBottom : KinematicBody::kLeftBottom;
 
-	// いまの位置基準の足元角を少しだけ下にずらして、そのセルの種類を調べる
-	const Vector3 footPos = CornerPosition(worldTransform_.translation_, footCorner) + Vector3(0.0f, -kBlank, 0.0f);
-	MapChipField::IndexSet idx = mapChipField_->GetMapChipIndexSetByPosition(footPos);
-	const MapChipType below = mapChipField_->GetMapChipTypeByIndex(idx.xIndex, idx.yIndex);
+	// いまの位置基準の足元角から真下へレイを飛ばし、余白の2倍以内に床の面があるかを見る
+	const Vector3 footPos = body.CornerPosition(worldTransform_.translation_, footCorner);
+	const bool hasFloor = mapChipField_->Raycast(footPos, MapChipField::RayDirection::kDown, kBlank * 2.0f).has_value();
 
-	// 空（ブロックでない）なら進行方向を反転
-	if (below != MapChipType::kBlock) {
+	// 床が無ければ（崖なら）進行方向を反転
+	if (!hasFloor) {
 		velocity_.x *= -1.0f;
 		RequestTurnByVelocity(); // ← イージングで振り向き
 	}
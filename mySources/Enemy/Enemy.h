@@ -1,12 +1,12 @@
 #pragma once
+#include "../KinematicBody/KinematicBody.h"
+#include "../TransformCache/TransformCache.h"
 #include "../struct.h"
 #include <KamataEngine.h>
-#include <array>
 
 using namespace KamataEngine;
 
 class Player;
-class MapChipField;
 
 class Enemy {
 private:
@@ -18,6 +18,7 @@ private:
 
 	// worldTransform
 	WorldTransform worldTransform_;
+	TransformCache transformCache_; // 動いたときだけ行列を作り直す
 
 	float deltaTime_; // デフォルトのデルタタイム（60FPS）
 
@@ -37,6 +38,9 @@ private:
 	// 速度
 	Vector3 velocity_ = {};
 
+	// 描画の補間用（直前の固定ステップ開始時の位置）
+	Vector3 previousTranslation_ = {};
+
 	// 最初の角度[度]
 	static inline const float kWalkMotionAngleStart = 0.0f;
 	// 最後の角度[度]
@@ -46,26 +50,13 @@ private:
 
 	float walkTimer_ = 0.0f; // 歩行アニメーションのタイマー
 
-	// ===== 衝突系の構造 =====
-	struct CollisionMapInfo {
-		bool cellingCollision = false; // 天井衝突フラグ
-		bool floorCollision = false;   // 床衝突フラグ
-		bool wallCollision = false;    // 壁衝突フラグ
-		Vector3 move;                  // 今フレームの移動量
-	};
-
-	enum Corner {
-		kRightBottom, // 右下
-		kLeftBottom,  // 左下
-		kRightTop,    // 右上
-		kLeftTop,     // 左上
-		kNumCorner    // 要素数
-	};
-
-	enum HitDir { kUp, kDown, kRight, kLeft, kCount };
-
+	// ===== 衝突系 =====
 	MapChipField* mapChipField_ = nullptr;
 
+	// マップとの当たり判定を行うボディ（Playerと共通）
+	KinematicBodySystem* kinematicBodies_ = nullptr;
+	KinematicBodySystem::BodyId bodyId_ = 0;
+
 	// 接地状態
 	bool onGround_ = false;
 	bool isDead_ = false;
@@ -80,8 +71,28 @@ private:
 	static inline const float kTimeTurn = 0.45f;   // 回転にかける時間（Playerと同値）
 
 public:
-	void Initialize(Camera* camera, const Vector3& position);
+	// 全員で共有するもの（シーンで1つ作り、生成のたびに作り直さない）
+	struct Prototype {
+		Model* model = nullptr;
+		Camera* camera = nullptr; // 初期化はシーン側で1回だけ行う
+		MapChipField* mapChipField = nullptr;
+		KinematicBodySystem* kinematicBodies = nullptr;
+		float deltaTime = 1.0f / 60.0f;
+		bool freefall = true;
+	};
+
+	~Enemy();
+
+	// 共有するものは prototype から参照をコピーするだけで、敵ごとの状態（位置・速度・ボディ）だけを作る
+	void Initialize(const Prototype& prototype, const Vector3& position);
+	// 重力と崖判定、移動量の計算まで。マップとの当たり判定は KinematicBodySystem がまとめて行う
 	void Update();
+	// 当たり判定の結果を反映する（KinematicBodySystem::ResolveMapCollisions の後に呼ぶ）
+	void UpdateAfterMapCollision();
+
+	// 直前の固定ステップと現在の位置を alpha で補間して描画用の行列を作る
+	void InterpolateTransform(float alpha);
+
 	void Draw();
 
 	void SetModel(Model* model) { model_ = model; }
@@ -95,6 +106,8 @@ public:
 
 	void SetDeltaTime(float deltaTime) { deltaTime_ = deltaTime; }
 	void SetMapChipField(MapChipField* mapChipField) { mapChipField_ = mapChipField; }
+	// ボディを登録する
+	void SetKinematicBodySystem(KinematicBodySystem* kinematicBodies);
 
 	void UpdateAffineTransformMatrix();
 
@@ -106,14 +119,9 @@ public:
 
 private:
 	// ====== 分割関数 ======
-	void CollisionMapCheck(CollisionMapInfo& info);
-	void CollisionOneSide(CollisionMapInfo& info, HitDir dir, const std::array<Vector3, kNumCorner>& positionsNew);
-	void MoveByCollisionCheck(const CollisionMapInfo& info);
-	Vector3 CornerPosition(const Vector3& center, Corner corner);
-
-	void OnCellingCollision(CollisionMapInfo& info);
-	void OnWallCollision(CollisionMapInfo& info);
-	void SwitchOnGround(CollisionMapInfo& info);
+	void OnCellingCollision(const KinematicBody& body);
+	void OnWallCollision(const KinematicBody& body);
+	void SwitchOnGround(const KinematicBody& body);
 
 	void LedgeTurnCheck();
 
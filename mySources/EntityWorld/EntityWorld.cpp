@@ -0,0 +1,233 @@
+#include "EntityWorld.h"
+#include "../FastMath/FastMath.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace KamataEngine::MathUtility;
+
+// ============================
+// エンティティの生成
+// ============================
+
+void EntityWorld::Reserve(size_t capacity) {
+	positionX_.reserve(capacity);
+	positionY_.reserve(capacity);
+	positionZ_.reserve(capacity);
+	velocityX_.reserve(capacity);
+	velocityY_.reserve(capacity);
+	halfExtentX_.reserve(capacity);
+	halfExtentY_.reserve(capacity);
+	halfExtentZ_.reserve(capacity);
+	scale_.reserve(capacity);
+	phase_.reserve(capacity);
+	rotateSpeed_.reserve(capacity);
+	flags_.reserve(capacity);
+	worldMatrices_.reserve(capacity);
+	transformIndex_.reserve(capacity);
+}
+
+void EntityWorld::Clear() {
+	positionX_.clear();
+	positionY_.clear();
+	positionZ_.clear();
+	velocityX_.clear();
+	velocityY_.clear();
+	halfExtentX_.clear();
+	halfExtentY_.clear();
+	halfExtentZ_.clear();
+	scale_.clear();
+	phase_.clear();
+	rotateSpeed_.clear();
+	flags_.clear();
+	worldMatrices_.clear();
+	transformIndex_.clear();
+	transforms_.clear();
+}
+
+EntityWorld::EntityId EntityWorld::Create(const Desc& desc) {
+
+	const EntityId id = static_cast<EntityId>(flags_.size());
+
+	positionX_.push_back(desc.position.x);
+	positionY_.push_back(desc.position.y);
+	positionZ_.push_back(desc.position.z);
+	velocityX_.push_back(desc.velocity.x);
+	velocityY_.push_back(desc.velocity.y);
+	halfExtentX_.push_back(desc.halfExtent.x);
+	halfExtentY_.push_back(desc.halfExtent.y);
+	halfExtentZ_.push_back(desc.halfExtent.z);
+	scale_.push_back(desc.scale);
+	phase_.push_back(0.0f);
+	rotateSpeed_.push_back(desc.rotateSpeed);
+	flags_.push_back(desc.flags | kEntityDirty);
+	worldMatrices_.push_back(MakeIdentityMatrix());
+
+	if (desc.flags & kEntityDrawable) {
+		transformIndex_.push_back(static_cast<uint32_t>(transforms_.size()));
+		WorldTransform& transform = transforms_.emplace_back();
+		transform.Initialize();
+		transform.translation_ = desc.position;
+		transform.scale_ = {desc.scale, desc.scale, desc.scale};
+	} else {
+		transformIndex_.push_back(UINT32_MAX);
+	}
+	return id;
+}
+
+AABB EntityWorld::GetAABB(EntityId id) const {
+	return {
+	    {positionX_[id] - halfExtentX_[id], positionY_[id] - halfExtentY_[id], positionZ_[id] - halfExtentZ_[id]},
+	    {positionX_[id] + halfExtentX_[id], positionY_[id] + halfExtentY_[id], positionZ_[id] + halfExtentZ_[id]}
+    };
+}
+
+size_t EntityWorld::Count(uint32_t required, uint32_t excluded) const {
+	return static_cast<size_t>(std::count_if(flags_.begin(), flags_.end(), [&](uint32_t flags) { return (flags & required) == required && (flags & excluded) == 0; }));
+}
+
+bool EntityWorld::Overlaps(EntityId id, const AABB& region) const {
+	// 範囲は XY 平面だけで見る
+	return positionX_[id] + halfExtentX_[id] >= region.min.x && positionX_[id] - halfExtentX_[id] <= region.max.x && //
+	       positionY_[id] + halfExtentY_[id] >= region.min.y && positionY_[id] - halfExtentY_[id] <= region.max.y;
+}
+
+// ============================
+// システム
+// ============================
+
+void EntityWorld::IntegrateVelocities(float deltaTime, const AABB& bounds) {
+
+	// 使うのは位置・速度・大きさ・フラグの配列だけ
+	const size_t count = flags_.size();
+	for (size_t i = 0; i < count; ++i) {
+		if (!(flags_[i] & kEntityMoving)) {
+			continue;
+		}
+
+		float x = positionX_[i] + velocityX_[i] * deltaTime;
+		float y = positionY_[i] + velocityY_[i] * deltaTime;
+
+		// 端に着いたら、その軸の速度を反転して内側へ戻す
+		const float minX = bounds.min.x + halfExtentX_[i];
+		const float maxX = bounds.max.x - halfExtentX_[i];
+		const float minY = bounds.min.y + halfExtentY_[i];
+		const float maxY = bounds.max.y - halfExtentY_[i];
+		if (x < minX || x > maxX) {
+			x = std::clamp(x, minX, maxX);
+			velocityX_[i] = -velocityX_[i];
+		}
+		if (y < minY || y > maxY) {
+			y = std::clamp(y, minY, maxY);
+			velocityY_[i] = -velocityY_[i];
+		}
+
+		positionX_[i] = x;
+		positionY_[i] = y;
+		flags_[i] |= kEntityDirty;
+	}
+}
+
+void EntityWorld::AdvanceAnimation(float deltaTime, const AABB& region) {
+	const size_t count = flags_.size();
+	for (size_t i = 0; i < count; ++i) {
+		if ((flags_[i] & (kEntityAnimated | kEntityCollected)) != kEntityAnimated) {
+			continue;
+		}
+		if (!Overlaps(static_cast<EntityId>(i), region)) {
+			continue;
+		}
+		phase_[i] += rotateSpeed_[i] * deltaTime;
+		if (rotateSpeed_[i] != 0.0f && deltaTime != 0.0f) {
+			flags_[i] |= kEntityDirty;
+		}
+	}
+}
+
+void EntityWorld::UpdateTransforms(const AABB& region, uint32_t required) {
+	// 作り直すものを先に集め、成分ごとの配列に詰める
+	const size_t count = flags_.size();
+	composeIds_.clear();
+	composeScale_.clear();
+	composeRotationY_.clear();
+	composePositionX_.clear();
+	composePositionY_.clear();
+	composePositionZ_.clear();
+	for (size_t i = 0; i < count; ++i) {
+		if ((flags_[i] & (required | kEntityDirty)) != (required | kEntityDirty) || (flags_[i] & kEntityCollected)) {
+			continue;
+		}
+		if (!Overlaps(static_cast<EntityId>(i), region)) {
+			continue;
+		}
+		composeIds_.push_back(static_cast<EntityId>(i));
+		composeScale_.push_back(scale_[i]);
+		composeRotationY_.push_back(phase_[i]);
+		composePositionX_.push_back(positionX_[i]);
+		composePositionY_.push_back(positionY_[i]);
+		composePositionZ_.push_back(positionZ_[i]);
+	}
+
+	// 拡縮 → Y 軸回転（位相） → 平行移動 をまとめて合成する
+	const size_t composeCount = composeIds_.size();
+	composeZero_.assign(composeCount, 0.0f);
+	composed_.resize(composeCount);
+	FastMath::TRSArrays input;
+	input.scaleX = input.scaleY = input.scaleZ = composeScale_.data();
+	input.rotationX = input.rotationZ = composeZero_.data();
+	input.rotationY = composeRotationY_.data();
+	input.translationX = composePositionX_.data();
+	input.translationY = composePositionY_.data();
+	input.translationZ = composePositionZ_.data();
+	FastMath::ComposeTRSBatch(input, composeCount, composed_.data());
+
+	uint32_t uploadCount = 0;
+	for (size_t k = 0; k < composeCount; ++k) {
+		const EntityId i = composeIds_[k];
+		worldMatrices_[i] = composed_[k];
+
+		if (transformIndex_[i] != UINT32_MAX) {
+			WorldTransform& transform = transforms_[transformIndex_[i]];
+			transform.translation_ = {positionX_[i], positionY_[i], positionZ_[i]};
+			transform.rotation_.y = phase_[i];
+			transform.matWorld_ = worldMatrices_[i];
+			transform.TransferMatrix();
+			++uploadCount;
+		}
+		flags_[i] &= ~kEntityDirty;
+	}
+	TransformCache::CountUpdates(static_cast<uint32_t>(composeCount), uploadCount);
+}
+
+void EntityWorld::CollectAABBs(uint32_t required, uint32_t excluded, const AABB& region, AABBBatch& boxes, std::vector<EntityId>& ids) const {
+	const size_t count = flags_.size();
+	for (size_t i = 0; i < count; ++i) {
+		if ((flags_[i] & required) != required || (flags_[i] & excluded)) {
+			continue;
+		}
+		const EntityId id = static_cast<EntityId>(i);
+		if (!Overlaps(id, region)) {
+			continue;
+		}
+		boxes.Add(GetAABB(id));
+		ids.push_back(id);
+	}
+}
+
+uint32_t EntityWorld::Draw(uint32_t required, const AABB& region, Model* model, const Camera& camera) {
+	if (!model) {
+		return 0;
+	}
+	uint32_t drawCount = 0;
+	const size_t count = flags_.size();
+	for (size_t i = 0; i < count; ++i) {
+		if ((flags_[i] & (required | kEntityDrawable)) != (required | kEntityDrawable) || (flags_[i] & kEntityCollected)) {
+			continue;
+		}
+		if (!Overlaps(static_cast<EntityId>(i), region)) {
+			continue;
+		}
+		model->Draw(transforms_[transformIndex_[i]], camera);
+		++drawCount;
+	}
+	return drawCount;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "../AABBBatch/AABBBatch.h"
+#include "../TransformCache/TransformCache.h"
+#include "../struct.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+using namespace KamataEngine;
+
+// エンティティの状態を表すビット（種類もここで表す）
+enum EntityFlag : uint32_t {
+	kEntityMoving = 1u << 0,    // 速度で動く
+	kEntityAnimated = 1u << 1,  // 回転アニメーションをする
+	kEntityDrawable = 1u << 2,  // モデルで描画する（WorldTransform を持つ）
+	kEntityCollected = 1u << 3, // 取得済み（更新・描画・当たり判定から外れる）
+	kEntityReached = 1u << 4,   // ゴール済み（当たり判定から外れる）
+	kEntityDirty = 1u << 5,     // 位置か位相が変わり、行列を作り直す必要がある（システムが立てて UpdateTransforms が下ろす）
+
+	kEntityCoin = 1u << 8,
+	kEntityGoal = 1u << 9,
+	kEntityWalker = 1u << 10, // 負荷試験用に動き回るだけのもの
+};
+
+// 小さな ECS
+// 位置・速度・当たり判定の大きさ・アニメーションの位相・フラグをそれぞれ別の配列（SoA）に持ち、
+// システム（下のメンバー関数）は自分が使う配列だけをなめる
+// エンティティは作った順の番号で、ステージ中は消さない（取得済みなどはフラグで外す）
+class EntityWorld {
+public:
+	using EntityId = uint32_t;
+
+	struct Desc {
+		Vector3 position = {};
+		Vector3 velocity = {};
+		Vector3 halfExtent = {0.5f, 0.5f, 0.5f}; // 当たり判定の箱の半分の大きさ
+		float scale = 1.0f;
+		float rotateSpeed = 0.0f; // アニメーションの回転速度[rad/s]
+		uint32_t flags = 0;
+	};
+
+	void Reserve(size_t capacity);
+	void Clear();
+
+	// kEntityDrawable なら WorldTransform も作る
+	EntityId Create(const Desc& desc);
+
+	size_t Size() const { return flags_.size(); }
+
+	uint32_t GetFlags(EntityId id) const { return flags_[id]; }
+	void AddFlags(EntityId id, uint32_t flags) { flags_[id] |= flags; }
+	bool HasFlags(EntityId id, uint32_t flags) const { return (flags_[id] & flags) == flags; }
+
+	Vector3 GetPosition(EntityId id) const { return {positionX_[id], positionY_[id], positionZ_[id]}; }
+	AABB GetAABB(EntityId id) const;
+
+	// required をすべて持ち、excluded をどれも持たないエンティティの数
+	size_t Count(uint32_t required, uint32_t excluded = 0) const;
+
+	// ============================
+	// システム
+	// ============================
+
+	// 速度で動かし、bounds の端で跳ね返す（kEntityMoving）
+	void IntegrateVelocities(float deltaTime, const AABB& bounds);
+
+	// region と重なるものの回転の位相を進める（kEntityAnimated、取得済みは除く）
+	void AdvanceAnimation(float deltaTime, const AABB& region);
+
+	// region と重なり kEntityDirty が立っているものだけワールド行列を作る（kEntityDrawable なら GPU にも送る）
+	void UpdateTransforms(const AABB& region, uint32_t required = 0);
+
+	// required をすべて持ち excluded をどれも持たないものの当たり判定の箱を、region と重なるものだけ boxes に詰める
+	// ids には箱の番号の順にエンティティを入れる
+	void CollectAABBs(uint32_t required, uint32_t excluded, const AABB& region, AABBBatch& boxes, std::vector<EntityId>& ids) const;
+
+	// required を持つ描画用のエンティティを region と重なるものだけ描く（取得済みは除く）。描いた数を返す
+	uint32_t Draw(uint32_t required, const AABB& region, Model* model, const Camera& camera);
+
+private:
+	// 位置
+	std::vector<float> positionX_;
+	std::vector<float> positionY_;
+	std::vector<float> positionZ_;
+	// 速度（XY 平面のみ）
+	std::vector<float> velocityX_;
+	std::vector<float> velocityY_;
+	// 当たり判定の箱の半分の大きさ
+	std::vector<float> halfExtentX_;
+	std::vector<float> halfExtentY_;
+	std::vector<float> halfExtentZ_;
+	// 見た目
+	std::vector<float> scale_;
+	std::vector<float> phase_;       // 回転アニメーションの位相（Y 軸回りの角度）
+	std::vector<float> rotateSpeed_;
+	std::vector<uint32_t> flags_;
+
+	// UpdateTransforms の結果
+	std::vector<Matrix4x4> worldMatrices_;
+
+	// 描画するものだけ WorldTransform を持つ（transformIndex_ が UINT32_MAX なら持たない）
+	std::vector<uint32_t> transformIndex_;
+	std::deque<WorldTransform> transforms_; // 増やしても作り直さない（GPU のバッファを持っているため）
+
+	// UpdateTransforms で合成するものを詰める作業用の配列（毎回確保し直さないように持っておく）
+	std::vector<EntityId> composeIds_;
+	std::vector<float> composeScale_;
+	std::vector<float> composeRotationY_;
+	std::vector<float> composePositionX_;
+	std::vector<float> composePositionY_;
+	std::vector<float> composePositionZ_;
+	std::vector<float> composeZero_;
+	std::vector<Matrix4x4> composed_;
+
+	bool Overlaps(EntityId id, const AABB& region) const;
+};
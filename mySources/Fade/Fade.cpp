@@ -19,7 +19,7 @@ void Fade::Update() {
 
 	case Status::FadeIn:
 
-		counter_ += 1.0f / 60.0f; // Assuming 60 FPS
+		counter_ += deltaTime_;
 		if (counter_ >= duration_) {
 			counter_ = duration_;
 		}
@@ -29,7 +29,7 @@ void Fade::Update() {
 
 	case Status::FadeOut:
 
-		counter_ += 1.0f / 60.0f; // Assuming 60 FPS
+		counter_ += deltaTime_;
 		if (counter_ >= duration_) {
 			counter_ = duration_;
 		}
@@ -26,6 +26,9 @@ public:
 
 	bool IsFinished();
 
+	// 1回の Update で進める時間（秒）
+	void SetDeltaTime(float deltaTime) { deltaTime_ = deltaTime; }
+
 	Status GetStatus() const { return status_; }
 	// 0.0～1.0 の正規化進捗
 	float GetNormalized() const { return (duration_ > 0.0f) ? std::clamp(counter_ / duration_, 0.0f, 1.0f) : 1.0f; }
@@ -44,6 +47,7 @@ private:
 
 	float duration_ = 0.0f;
 	float counter_ = 0.0f;
+	float deltaTime_ = 1.0f / 60.0f;
 
 	bool isFinished_ = false;
 };
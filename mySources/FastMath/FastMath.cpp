@@ -0,0 +1,326 @@
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+#ifdef _DEBUG
+#include <chrono>
+#include <random>
+#include <vector>
+#endif // _DEBUG
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FAST_MATH_SSE2
+#endif
+
+using namespace KamataEngine::MathUtility;
+
+namespace FastMath {
+
+// ============================
+// 型の変換
+// ============================
+
+Matrix4x4A::Matrix4x4A(const Matrix4x4& matrix) { std::copy(&matrix.m[0][0], &matrix.m[0][0] + 16, &m[0][0]); }
+
+Matrix4x4A::operator Matrix4x4() const {
+	Matrix4x4 matrix;
+	std::copy(&m[0][0], &m[0][0] + 16, &matrix.m[0][0]);
+	return matrix;
+}
+
+// ============================
+// 行列・ベクトル
+// ============================
+
+Matrix4x4A Multiply(const Matrix4x4A& lhs, const Matrix4x4A& rhs) {
+	Matrix4x4A result;
+#if defined(FAST_MATH_SSE2)
+	const __m128 rhs0 = _mm_load_ps(rhs.m[0]);
+	const __m128 rhs1 = _mm_load_ps(rhs.m[1]);
+	const __m128 rhs2 = _mm_load_ps(rhs.m[2]);
+	const __m128 rhs3 = _mm_load_ps(rhs.m[3]);
+	for (int i = 0; i < 4; ++i) {
+		// 結果の i 行目 = lhs の i 行目の各成分で rhs の各行を重み付けして足したもの
+		__m128 row = _mm_mul_ps(_mm_set1_ps(lhs.m[i][0]), rhs0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.m[i][1]), rhs1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.m[i][2]), rhs2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lhs.m[i][3]), rhs3));
+		_mm_store_ps(result.m[i], row);
+	}
+#else
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = lhs.m[i][0] * rhs.m[0][j] + lhs.m[i][1] * rhs.m[1][j] + lhs.m[i][2] * rhs.m[2][j] + lhs.m[i][3] * rhs.m[3][j];
+		}
+	}
+#endif
+	return result;
+}
+
+Vector3A TransformPoint(const Vector3A& point, const Matrix4x4A& matrix) {
+	Vector3A result;
+#if defined(FAST_MATH_SSE2)
+	__m128 row = _mm_load_ps(matrix.m[3]);
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(point.x), _mm_load_ps(matrix.m[0])));
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(point.y), _mm_load_ps(matrix.m[1])));
+	row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(point.z), _mm_load_ps(matrix.m[2])));
+	alignas(16) float values[4];
+	_mm_store_ps(values, row);
+	result.x = values[0] / values[3];
+	result.y = values[1] / values[3];
+	result.z = values[2] / values[3];
+#else
+	const float w = point.x * matrix.m[0][3] + point.y * matrix.m[1][3] + point.z * matrix.m[2][3] + matrix.m[3][3];
+	result.x = (point.x * matrix.m[0][0] + point.y * matrix.m[1][0] + point.z * matrix.m[2][0] + matrix.m[3][0]) / w;
+	result.y = (point.x * matrix.m[0][1] + point.y * matrix.m[1][1] + point.z * matrix.m[2][1] + matrix.m[3][1]) / w;
+	result.z = (point.x * matrix.m[0][2] + point.y * matrix.m[1][2] + point.z * matrix.m[2][2] + matrix.m[3][2]) / w;
+#endif
+	return result;
+}
+
+// ============================
+// 拡縮・回転・平行移動の合成
+// ============================
+
+// Rz * Ry * Rx を展開すると、各行は次のようになる（c? / s? は各軸の cos / sin）
+//   0行目 : ( cz*cy,  sz*cx + cz*sy*sx,  sz*sx - cz*sy*cx )
+//   1行目 : (-sz*cy,  cz*cx - sz*sy*sx,  cz*sx + sz*sy*cx )
+//   2行目 : ( sy,    -cy*sx,             cy*cx            )
+// 左から拡縮を掛けると各行がその軸の拡縮倍になり、右から平行移動を掛けると3行目に移動量が入る
+Matrix4x4 ComposeTRS(const Vector3& scale, const Vector3& rotation, const Vector3& translation) {
+
+	const float sinX = std::sin(rotation.x);
+	const float cosX = std::cos(rotation.x);
+	const float sinY = std::sin(rotation.y);
+	const float cosY = std::cos(rotation.y);
+	const float sinZ = std::sin(rotation.z);
+	const float cosZ = std::cos(rotation.z);
+
+	Matrix4x4 result;
+	result.m[0][0] = scale.x * (cosZ * cosY);
+	result.m[0][1] = scale.x * (sinZ * cosX + cosZ * sinY * sinX);
+	result.m[0][2] = scale.x * (sinZ * sinX - cosZ * sinY * cosX);
+	result.m[0][3] = 0.0f;
+
+	result.m[1][0] = scale.y * (-sinZ * cosY);
+	result.m[1][1] = scale.y * (cosZ * cosX - sinZ * sinY * sinX);
+	result.m[1][2] = scale.y * (cosZ * sinX + sinZ * sinY * cosX);
+	result.m[1][3] = 0.0f;
+
+	result.m[2][0] = scale.z * sinY;
+	result.m[2][1] = scale.z * (-cosY * sinX);
+	result.m[2][2] = scale.z * (cosY * cosX);
+	result.m[2][3] = 0.0f;
+
+	result.m[3][0] = translation.x;
+	result.m[3][1] = translation.y;
+	result.m[3][2] = translation.z;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+#if defined(FAST_MATH_SSE2)
+
+// 4つの角度の sin / cos をまとめて求める
+// 角度を π/2 単位でずらして [-π/4, π/4] に収め、多項式で近似してから象限に合わせて入れ替える
+// 誤差は std::sin / std::cos と比べて 1e-6 程度（角度が数千ラジアンを超えると落ちていく）
+static void SinCos4(__m128 angle, __m128& sinOut, __m128& cosOut) {
+
+	const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(angle, _mm_set1_ps(0.63661977236758134f))); // round(angle / (π/2))
+	const __m128 quadrantF = _mm_cvtepi32_ps(quadrant);
+
+	// π/2 を3つに分けて引き、桁落ちを抑える
+	__m128 r = _mm_sub_ps(angle, _mm_mul_ps(quadrantF, _mm_set1_ps(1.5703125f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, _mm_set1_ps(4.837512969970703125e-4f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, _mm_set1_ps(7.54978995489188216e-8f)));
+	const __m128 r2 = _mm_mul_ps(r, r);
+
+	// sin(r) ≒ r + r^3 * (s1 + r^2 * (s2 + r^2 * s3))
+	__m128 polySin = _mm_add_ps(_mm_set1_ps(8.3321608736e-3f), _mm_mul_ps(r2, _mm_set1_ps(-1.9515295891e-4f)));
+	polySin = _mm_add_ps(_mm_set1_ps(-1.6666654611e-1f), _mm_mul_ps(r2, polySin));
+	polySin = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r2, r), polySin));
+
+	// cos(r) ≒ 1 - r^2 / 2 + r^4 * (c1 + r^2 * (c2 + r^2 * c3))
+	__m128 polyCos = _mm_add_ps(_mm_set1_ps(-1.388731625493765e-3f), _mm_mul_ps(r2, _mm_set1_ps(2.443315711809948e-5f)));
+	polyCos = _mm_add_ps(_mm_set1_ps(4.166664568298827e-2f), _mm_mul_ps(r2, polyCos));
+	polyCos = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_mul_ps(_mm_mul_ps(r2, r2), polyCos));
+
+	// 奇数の象限では sin と cos が入れ替わる
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+	const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+	const __m128 sinValue = _mm_or_ps(_mm_and_ps(swap, polyCos), _mm_andnot_ps(swap, polySin));
+	const __m128 cosValue = _mm_or_ps(_mm_and_ps(swap, polySin), _mm_andnot_ps(swap, polyCos));
+
+	// 符号は sin が象限の2ビット目、cos が象限 + 1 の2ビット目で反転する
+	const __m128 signBit = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+	const __m128 sinNegate = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, two), two));
+	const __m128 cosNegate = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), two));
+	sinOut = _mm_xor_ps(sinValue, _mm_and_ps(sinNegate, signBit));
+	cosOut = _mm_xor_ps(cosValue, _mm_and_ps(cosNegate, signBit));
+}
+
+#endif
+
+void ComposeTRSBatch(const TRSArrays& input, size_t count, Matrix4x4* out) {
+
+	size_t i = 0;
+
+#if defined(FAST_MATH_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 oneF = _mm_set1_ps(1.0f);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos4(_mm_loadu_ps(input.rotationX + i), sinX, cosX);
+		SinCos4(_mm_loadu_ps(input.rotationY + i), sinY, cosY);
+		SinCos4(_mm_loadu_ps(input.rotationZ + i), sinZ, cosZ);
+
+		const __m128 scaleX = _mm_loadu_ps(input.scaleX + i);
+		const __m128 scaleY = _mm_loadu_ps(input.scaleY + i);
+		const __m128 scaleZ = _mm_loadu_ps(input.scaleZ + i);
+
+		// ComposeTRS と同じ式を4つ分まとめて求める
+		const __m128 sinYsinX = _mm_mul_ps(sinY, sinX);
+		const __m128 sinYcosX = _mm_mul_ps(sinY, cosX);
+
+		__m128 m00 = _mm_mul_ps(scaleX, _mm_mul_ps(cosZ, cosY));
+		__m128 m01 = _mm_mul_ps(scaleX, _mm_add_ps(_mm_mul_ps(sinZ, cosX), _mm_mul_ps(cosZ, sinYsinX)));
+		__m128 m02 = _mm_mul_ps(scaleX, _mm_sub_ps(_mm_mul_ps(sinZ, sinX), _mm_mul_ps(cosZ, sinYcosX)));
+		__m128 m03 = zero;
+
+		__m128 m10 = _mm_mul_ps(scaleY, _mm_sub_ps(zero, _mm_mul_ps(sinZ, cosY)));
+		__m128 m11 = _mm_mul_ps(scaleY, _mm_sub_ps(_mm_mul_ps(cosZ, cosX), _mm_mul_ps(sinZ, sinYsinX)));
+		__m128 m12 = _mm_mul_ps(scaleY, _mm_add_ps(_mm_mul_ps(cosZ, sinX), _mm_mul_ps(sinZ, sinYcosX)));
+		__m128 m13 = zero;
+
+		__m128 m20 = _mm_mul_ps(scaleZ, sinY);
+		__m128 m21 = _mm_mul_ps(scaleZ, _mm_sub_ps(zero, _mm_mul_ps(cosY, sinX)));
+		__m128 m22 = _mm_mul_ps(scaleZ, _mm_mul_ps(cosY, cosX));
+		__m128 m23 = zero;
+
+		__m128 m30 = _mm_loadu_ps(input.translationX + i);
+		__m128 m31 = _mm_loadu_ps(input.translationY + i);
+		__m128 m32 = _mm_loadu_ps(input.translationZ + i);
+		__m128 m33 = oneF;
+
+		// 成分ごとに4つ並んでいるものを、行列ごとの行に並べ替えて書き出す
+		_MM_TRANSPOSE4_PS(m00, m01, m02, m03);
+		_MM_TRANSPOSE4_PS(m10, m11, m12, m13);
+		_MM_TRANSPOSE4_PS(m20, m21, m22, m23);
+		_MM_TRANSPOSE4_PS(m30, m31, m32, m33);
+		const __m128 rows[4][4] = {
+		    {m00, m10, m20, m30},
+		    {m01, m11, m21, m31},
+		    {m02, m12, m22, m32},
+		    {m03, m13, m23, m33},
+		};
+		for (size_t lane = 0; lane < 4; ++lane) {
+			for (size_t row = 0; row < 4; ++row) {
+				_mm_storeu_ps(out[i + lane].m[row], rows[lane][row]);
+			}
+		}
+	}
+#endif
+
+	// 端数（SSE2 が無ければ全部）は1つずつ
+	for (; i < count; ++i) {
+		out[i] = ComposeTRS({input.scaleX[i], input.scaleY[i], input.scaleZ[i]}, {input.rotationX[i], input.rotationY[i], input.rotationZ[i]},
+		                    {input.translationX[i], input.translationY[i], input.translationZ[i]});
+	}
+}
+
+const char* GetKernelName() {
+#if defined(FAST_MATH_SSE2)
+	return "SSE2";
+#else
+	return "スカラー";
+#endif
+}
+
+} // namespace FastMath
+
+#ifdef _DEBUG
+// ============================
+// ベンチマーク
+// ============================
+
+ComposeTRSBenchmark RunComposeTRSBenchmark(size_t transformCount) {
+
+	// ゲーム中と同じくらいの値をばらまく（乱数は固定）
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	std::uniform_real_distribution<float> angle(-3.1415926535f, 3.1415926535f);
+	std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+
+	std::vector<float> values[9];
+	for (std::vector<float>& component : values) {
+		component.resize(transformCount);
+	}
+	for (size_t i = 0; i < transformCount; ++i) {
+		values[0][i] = scale(random);
+		values[1][i] = scale(random);
+		values[2][i] = scale(random);
+		values[3][i] = angle(random);
+		values[4][i] = angle(random);
+		values[5][i] = angle(random);
+		values[6][i] = position(random);
+		values[7][i] = position(random);
+		values[8][i] = position(random);
+	}
+
+	std::vector<Matrix4x4> mathUtilityResults(transformCount);
+	std::vector<Matrix4x4> composeResults(transformCount);
+	std::vector<Matrix4x4> batchResults(transformCount);
+
+	// これまでの書き方（行列を5つ作って4回掛ける）
+	const auto mathUtilityBegin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < transformCount; ++i) {
+		Matrix4x4 scaleMat = MakeScaleMatrix({values[0][i], values[1][i], values[2][i]});
+		Matrix4x4 rotZMat = MakeRotateZMatrix(values[5][i]);
+		Matrix4x4 rotYMat = MakeRotateYMatrix(values[4][i]);
+		Matrix4x4 rotXMat = MakeRotateXMatrix(values[3][i]);
+		Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
+		Matrix4x4 transMat = MakeTranslateMatrix({values[6][i], values[7][i], values[8][i]});
+		mathUtilityResults[i] = scaleMat * rotMat * transMat;
+	}
+	const auto composeBegin = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < transformCount; ++i) {
+		composeResults[i] = FastMath::ComposeTRS({values[0][i], values[1][i], values[2][i]}, {values[3][i], values[4][i], values[5][i]}, {values[6][i], values[7][i], values[8][i]});
+	}
+	const auto batchBegin = std::chrono::steady_clock::now();
+	FastMath::TRSArrays input;
+	input.scaleX = values[0].data();
+	input.scaleY = values[1].data();
+	input.scaleZ = values[2].data();
+	input.rotationX = values[3].data();
+	input.rotationY = values[4].data();
+	input.rotationZ = values[5].data();
+	input.translationX = values[6].data();
+	input.translationY = values[7].data();
+	input.translationZ = values[8].data();
+	FastMath::ComposeTRSBatch(input, transformCount, batchResults.data());
+	const auto batchEnd = std::chrono::steady_clock::now();
+
+	ComposeTRSBenchmark result;
+	result.transformCount = transformCount;
+	if (transformCount > 0) {
+		const double count = static_cast<double>(transformCount);
+		result.mathUtilityNanoseconds = std::chrono::duration<double, std::nano>(composeBegin - mathUtilityBegin).count() / count;
+		result.composeNanoseconds = std::chrono::duration<double, std::nano>(batchBegin - composeBegin).count() / count;
+		result.batchNanoseconds = std::chrono::duration<double, std::nano>(batchEnd - batchBegin).count() / count;
+	}
+
+	// 最適化で消されないよう結果を使い、ついでに差も測る
+	for (size_t i = 0; i < transformCount; ++i) {
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				const float expected = mathUtilityResults[i].m[row][column];
+				result.maxError = (std::max)(result.maxError, std::abs(composeResults[i].m[row][column] - expected));
+				result.maxError = (std::max)(result.maxError, std::abs(batchResults[i].m[row][column] - expected));
+			}
+		}
+	}
+	return result;
+}
+#endif // _DEBUG
@@ -0,0 +1,78 @@
+#pragma once
+#include <KamataEngine.h>
+#include <cstddef>
+#include <cstdint>
+
+using namespace KamataEngine;
+
+// 行列計算を速くするための小さな数学ライブラリ
+// MathUtility と同じ行ベクトルの約束（拡縮 * 回転(Z * Y * X) * 平行移動）で、結果も同じ行列になる
+namespace FastMath {
+
+// SSE でそのまま読み書きできる 16 バイト境界の型
+// Vector3 は w を 0 で埋めて4成分として扱う
+struct alignas(16) Vector3A {
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+	float w = 0.0f;
+
+	Vector3A() = default;
+	Vector3A(const Vector3& v) : x(v.x), y(v.y), z(v.z) {}
+	operator Vector3() const { return {x, y, z}; }
+};
+
+struct alignas(16) Matrix4x4A {
+	float m[4][4] = {};
+
+	Matrix4x4A() = default;
+	Matrix4x4A(const Matrix4x4& matrix);
+	operator Matrix4x4() const;
+};
+
+// 行列の積（SSE で1行ずつ求める）
+Matrix4x4A Multiply(const Matrix4x4A& lhs, const Matrix4x4A& rhs);
+// 点の変換（w = 1 として掛け、w で割る）
+Vector3A TransformPoint(const Vector3A& point, const Matrix4x4A& matrix);
+
+// ============================
+// 拡縮・回転・平行移動の合成
+// ============================
+
+// MakeScaleMatrix(scale) * MakeRotateZ * MakeRotateY * MakeRotateX * MakeTranslateMatrix(translation) を
+// 行列の積を使わずに直接求める（回転は各軸の sin / cos を1回ずつ求めるだけ）
+Matrix4x4 ComposeTRS(const Vector3& scale, const Vector3& rotation, const Vector3& translation);
+
+// 成分ごとの配列（SoA）で渡す、まとめて合成する入力。すべて count 個ずつ
+struct TRSArrays {
+	const float* scaleX = nullptr;
+	const float* scaleY = nullptr;
+	const float* scaleZ = nullptr;
+	const float* rotationX = nullptr;
+	const float* rotationY = nullptr;
+	const float* rotationZ = nullptr;
+	const float* translationX = nullptr;
+	const float* translationY = nullptr;
+	const float* translationZ = nullptr;
+};
+
+// ComposeTRS を count 個まとめて行う。SSE2 が使えれば4つずつ（sin / cos も4つまとめて）求める
+void ComposeTRSBatch(const TRSArrays& input, size_t count, Matrix4x4* out);
+
+// ComposeTRSBatch で使われる命令セットの名前
+const char* GetKernelName();
+
+} // namespace FastMath
+
+#ifdef _DEBUG
+// MathUtility の5回の行列の積・ComposeTRS・ComposeTRSBatch の速さを比べる（デバッグ表示用）
+struct ComposeTRSBenchmark {
+	size_t transformCount = 0;
+	double mathUtilityNanoseconds = 0.0; // 1つあたり
+	double composeNanoseconds = 0.0;
+	double batchNanoseconds = 0.0;
+	float maxError = 0.0f; // MathUtility の結果との成分ごとの差の最大
+};
+
+ComposeTRSBenchmark RunComposeTRSBenchmark(size_t transformCount);
+#endif // _DEBUG
@@ -1,5 +1,7 @@
 #include "Game.h"
 #include "CommonBGM/CommonBGM.h"
+#include <algorithm>
+#include <cmath>
 
 Game::~Game() {
 	CommonBGM::GetInstance()->Stop();
@@ -59,6 +61,8 @@ void Game::Update() {
 	// ImGuiの開始
 	imguiManager->Begin();
 
+	AdvanceFrameTime();
+
 	UpdateScene();
 
 	// ImGuiの終了
@@ -73,6 +77,33 @@ void Game::Draw() {
 	imguiManager->Draw();
 }
 
+void Game::AdvanceFrameTime() {
+
+	const auto now = std::chrono::steady_clock::now();
+	if (hasPreviousFrameTime_) {
+		frameDeltaTime_ = std::chrono::duration<float>(now - previousFrameTime_).count();
+		frameDeltaTime_ = (std::min)(frameDeltaTime_, kMaxFrameTime);
+		// 60Hz表示ではタイマーの揺れで0回と2回のステップが交互に出ないよう、ほぼ1ステップ分なら揃える
+		if (std::fabs(frameDeltaTime_ - kFixedDeltaTime) < kFrameSnapTolerance) {
+			frameDeltaTime_ = kFixedDeltaTime;
+		}
+	} else {
+		// 最初のフレームは1ステップ分とみなす
+		frameDeltaTime_ = kFixedDeltaTime;
+		hasPreviousFrameTime_ = true;
+	}
+	previousFrameTime_ = now;
+
+	// 溜まった時間を固定ステップで消化し、端数は次のフレームへ持ち越す
+	accumulator_ += frameDeltaTime_;
+	fixedSteps_ = 0;
+	while (accumulator_ >= kFixedDeltaTime) {
+		accumulator_ -= kFixedDeltaTime;
+		++fixedSteps_;
+	}
+	interpolationAlpha_ = accumulator_ / kFixedDeltaTime;
+}
+
 void Game::ChangeScene() {
 	switch (scene) {
 	case Scene::kTitle:
@@ -136,17 +167,20 @@ void Game::UpdateScene() {
 	case Scene::kTitle:
 
 		// タイトルシーンの更新
+		titleScene->SetDeltaTime(frameDeltaTime_);
 		titleScene->Update();
 
 		break;
 	case Scene::kStageSelect:
 
+		stageSelectScene->SetDeltaTime(frameDeltaTime_);
 		stageSelectScene->Update();
 
 		break;
 	case Scene::kGame:
 
-		// ゲームシーンの更新
+		// ゲームシーンの更新（ゲームの進行は固定ステップ、フェードやカメラは実時間）
+		gameScene->SetFrameTiming(frameDeltaTime_, fixedSteps_, interpolationAlpha_);
 		gameScene->Update();
 
 		break;
@@ -3,6 +3,8 @@
 #include "TitleScene/TitleScene.h"
 #include "SelectScene/StageSelectScene.h"
 #include <KamataEngine.h>
+#include <chrono>
+#include <cstdint>
 
 using namespace KamataEngine;
 
@@ -38,6 +40,28 @@ private:
 
 	std::string lastSelectedCSV_ = "Resources/csv/stage1.csv";
 
+	// ======================
+	// 固定ステップ
+	// ======================
+
+	// ゲームは常にこの刻みで進め、表示のフレームレートとは切り離す
+	static inline const float kFixedDeltaTime = 1.0f / 60.0f;
+	// これより長いフレーム（ブレークポイント・読み込み待ちなど）は切り詰め、一度に大量のステップを回さない
+	static inline const float kMaxFrameTime = 0.25f;
+	// 経過時間が固定ステップとこの差以内なら、ちょうど1ステップ分として扱う
+	static inline const float kFrameSnapTolerance = 0.0002f;
+
+	std::chrono::steady_clock::time_point previousFrameTime_ = {};
+	bool hasPreviousFrameTime_ = false;
+
+	float frameDeltaTime_ = kFixedDeltaTime; // 今フレームの経過時間
+	float accumulator_ = 0.0f;               // まだステップとして進めていない時間
+	uint32_t fixedSteps_ = 0;                // 今フレームに進める固定ステップ数
+	float interpolationAlpha_ = 1.0f;        // 余った時間の割合（描画の補間用）
+
+	// 経過時間を積み、今フレームに進める固定ステップ数を決める
+	void AdvanceFrameTime();
+
 	void ChangeScene();
 
 	void UpdateScene();
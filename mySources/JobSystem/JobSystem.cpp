@@ -0,0 +1,130 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+// ============================
+// 生成・破棄
+// ============================
+
+JobSystem::JobSystem(uint32_t workerCount) {
+
+	if (workerCount == 0) {
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+	}
+	workerCount = (std::min)(workerCount, kMaxWorkerCount);
+
+	for (uint32_t i = 0; i < workerCount + 1; ++i) {
+		queues_.push_back(std::make_unique<JobQueue>());
+	}
+	for (uint32_t i = 0; i < workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		stop_ = true;
+	}
+	wakeCondition_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+}
+
+// ============================
+// ジョブの配布と実行
+// ============================
+
+void JobSystem::Dispatch(void* context, RangeFunction invoke, uint32_t count, uint32_t grainSize) {
+
+	if (count == 0) {
+		return;
+	}
+	grainSize = (std::max)(grainSize, 1u);
+
+	// ワーカーがいない・1ジョブで足りるなら、その場で順番に処理する
+	if (workers_.empty() || count <= grainSize) {
+		invoke(context, 0, count);
+		return;
+	}
+
+	// grainSize 個ずつに分け、キューへ順番に配る
+	// 数は先に足しておく（積んでいる途中で取られても 0 を下回らない）
+	const uint32_t jobCount = (count + grainSize - 1) / grainSize;
+	unfinishedJobs_.fetch_add(jobCount);
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		queuedJobs_.fetch_add(jobCount);
+	}
+	for (uint32_t i = 0; i < jobCount; ++i) {
+		const uint32_t begin = i * grainSize;
+		const uint32_t end = (std::min)(begin + grainSize, count);
+		JobQueue& queue = *queues_[i % queues_.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({context, invoke, begin, end});
+	}
+	wakeCondition_.notify_all();
+
+	// 呼び出し側も処理に加わり、全部終わるまで待つ
+	while (unfinishedJobs_.load(std::memory_order_acquire) > 0) {
+		if (!RunOneJob(0)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::PopJob(uint32_t queueIndex, Job& job) {
+
+	// 自分のキューは前から（配られた順に処理する）
+	{
+		JobQueue& own = *queues_[queueIndex];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.jobs.empty()) {
+			job = own.jobs.front();
+			own.jobs.pop_front();
+			return true;
+		}
+	}
+
+	// 空なら隣から順に、他のキューの後ろから盗む
+	for (size_t offset = 1; offset < queues_.size(); ++offset) {
+		JobQueue& victim = *queues_[(queueIndex + offset) % queues_.size()];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			job = victim.jobs.back();
+			victim.jobs.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+bool JobSystem::RunOneJob(uint32_t queueIndex) {
+	Job job;
+	if (!PopJob(queueIndex, job)) {
+		return false;
+	}
+	queuedJobs_.fetch_sub(1);
+
+	job.invoke(job.context, job.begin, job.end);
+
+	// 結果の書き込みが完了待ちのスレッドから見えるように release で減らす
+	unfinishedJobs_.fetch_sub(1, std::memory_order_release);
+	return true;
+}
+
+void JobSystem::WorkerMain(uint32_t queueIndex) {
+	for (;;) {
+		if (RunOneJob(queueIndex)) {
+			continue;
+		}
+
+		// キューが空なら次の ParallelFor まで眠る
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		wakeCondition_.wait(lock, [&] { return stop_ || queuedJobs_.load() > 0; });
+		if (stop_) {
+			return;
+		}
+	}
+}
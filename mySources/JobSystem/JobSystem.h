@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// 小さなワークスティーリング型のジョブシステム
+// ParallelFor で範囲を分けてスレッドごとのキューに配り、手が空いたスレッドは他のキューの後ろから盗む
+// 呼び出し側のスレッドも一緒に処理し、すべて終わるまで戻らない
+class JobSystem {
+public:
+	// workerCount = 0 ならコア数 - 1（呼び出し側の分）だけワーカーを立てる
+	explicit JobSystem(uint32_t workerCount = 0);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// func(index) を [0, count) について呼ぶ。grainSize 個ずつを1つのジョブにする
+	// 各 index の処理が自分の担当分しか書き換えなければ、順番に呼んだときと結果は同じになる
+	template <typename Func> void ParallelFor(uint32_t count, uint32_t grainSize, Func&& func) {
+		using FuncType = std::remove_reference_t<Func>;
+		const RangeFunction invoke = [](void* context, uint32_t begin, uint32_t end) {
+			FuncType& f = *static_cast<FuncType*>(context);
+			for (uint32_t i = begin; i < end; ++i) {
+				f(i);
+			}
+		};
+		Dispatch(const_cast<void*>(static_cast<const void*>(&func)), invoke, count, grainSize);
+	}
+
+	// ワーカースレッドの数（呼び出し側のスレッドは含まない）
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+private:
+	using RangeFunction = void (*)(void* context, uint32_t begin, uint32_t end);
+
+	struct Job {
+		void* context = nullptr;
+		RangeFunction invoke = nullptr;
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	// スレッドごとのキュー（持ち主は前から、盗む側は後ろから取る）
+	struct JobQueue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	// ワーカーの上限（敵の更新程度なら、これ以上増やしても待ちが増えるだけ）
+	static inline const uint32_t kMaxWorkerCount = 7;
+
+	std::vector<std::unique_ptr<JobQueue>> queues_; // [0] は呼び出し側、[1..] はワーカー
+	std::vector<std::thread> workers_;
+
+	std::atomic<uint32_t> queuedJobs_ = 0;   // キューに残っているジョブ数（ワーカーを寝かせる判断用）
+	std::atomic<uint32_t> unfinishedJobs_ = 0; // まだ終わっていないジョブ数（ParallelFor の完了待ち用）
+
+	std::mutex sleepMutex_;
+	std::condition_variable wakeCondition_;
+	bool stop_ = false;
+
+	void Dispatch(void* context, RangeFunction invoke, uint32_t count, uint32_t grainSize);
+
+	// 自分のキューの前から、空なら他のキューの後ろから1つ取って実行する
+	bool RunOneJob(uint32_t queueIndex);
+	bool PopJob(uint32_t queueIndex, Job& job);
+
+	void WorkerMain(uint32_t queueIndex);
+};
@@ -0,0 +1,278 @@
+#include "KinematicBody.h"
+#include "../JobSystem/JobSystem.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace KamataEngine::MathUtility;
+
+// ============================
+// 角の座標を計算
+// ============================
+Vector3 KinematicBody::CornerPosition(const Vector3& center, Corner corner) const {
+	Vector3 offsetTable[kNumCorner] = {
+	    {+width / 2.0f, -height / 2.0f, 0.0f}, //  右下
+	    {-width / 2.0f, -height / 2.0f, 0.0f}, //  左下
+	    {+width / 2.0f, +height / 2.0f, 0.0f}, //  右上
+	    {-width / 2.0f, +height / 2.0f, 0.0f}  //  左上
+	};
+	return center + offsetTable[static_cast<uint32_t>(corner)];
+}
+
+// ============================
+// ボディの生成・破棄
+// ============================
+
+KinematicBodySystem::BodyId KinematicBodySystem::Create(float width, float height, float blank) {
+
+	// 空きスロットがあれば再利用して、配列を詰めたままにする
+	BodyId id = 0;
+	if (!freeIds_.empty()) {
+		id = freeIds_.back();
+		freeIds_.pop_back();
+	} else {
+		id = static_cast<BodyId>(bodies_.size());
+		bodies_.emplace_back();
+	}
+
+	KinematicBody& body = bodies_[id];
+	body = {};
+	body.width = width;
+	body.height = height;
+	body.blank = blank;
+	body.alive = true;
+	return id;
+}
+
+void KinematicBodySystem::Destroy(BodyId id) {
+	if (id >= bodies_.size() || !bodies_[id].alive) {
+		return;
+	}
+	bodies_[id].alive = false;
+	bodies_[id].pending = false;
+	freeIds_.push_back(id);
+}
+
+void KinematicBodySystem::Submit(BodyId id, const Vector3& position, const Vector3& move) {
+	KinematicBody& body = bodies_[id];
+	body.position = position;
+	body.move = move;
+	body.cellingCollision = false;
+	body.floorCollision = false;
+	body.wallCollision = false;
+	body.groundBelow = false;
+	body.pending = true;
+}
+
+// ============================
+// まとめて解決
+// ============================
+
+void KinematicBodySystem::ResolveMapCollisions() {
+	// 配列を先頭から1回なめるだけ（キャラクターごとの仮想呼び出しやポインタ追跡をしない）
+	// 各ボディはマップを読んで自分だけを書き換えるので、分けて並列に解いても結果は変わらない
+	const auto resolve = [&](uint32_t index) {
+		KinematicBody& body = bodies_[index];
+		if (!body.pending) {
+			return;
+		}
+		Resolve(body);
+		body.pending = false;
+	};
+
+	if (jobSystem_) {
+		jobSystem_->ParallelFor(static_cast<uint32_t>(bodies_.size()), kResolveGrainSize, resolve);
+	} else {
+		for (uint32_t i = 0; i < bodies_.size(); ++i) {
+			resolve(i);
+		}
+	}
+}
+
+void KinematicBodySystem::Resolve(KinematicBody& body) const {
+
+	// マップ未設定ならそのまま移動
+	if (!mapChipField_) {
+		body.position += body.move;
+		return;
+	}
+
+	if (std::fabs(body.move.x) > kDiscreteMoveLimit || std::fabs(body.move.y) > kDiscreteMoveLimit) {
+		// 速い・フレーム時間が長いときは、移動後だけを見るとブロックをすり抜けるので連続判定にする
+		ResolveSwept(body);
+	} else {
+		// 移動後の当たり判定の範囲を一度だけ問い合わせ、4方向の判定で使い回す
+		const Vector3 positionNew = body.position + body.move;
+		const AABB aabbNew = {positionNew - Vector3(body.width / 2.0f, body.height / 2.0f, 0.0f), positionNew + Vector3(body.width / 2.0f, body.height / 2.0f, 0.0f)};
+		const MapChipField::SolidQuery query = mapChipField_->QuerySolids(aabbNew);
+
+		// 範囲内にブロックが1つも無ければどの方向にも当たらない
+		if (!query.Empty()) {
+			// 上下左右の順で4回呼ぶ
+			const HitDir order[] = {HitDir::kUp, HitDir::kDown, HitDir::kRight, HitDir::kLeft};
+			for (HitDir d : order) {
+				ResolveOneSide(body, d, query);
+			}
+		}
+	}
+
+	// 判定結果を反映して移動させる
+	body.position += body.move;
+
+	// 接地の切り替え用に、移動後からさらに同じだけ進んだ位置の足元（下の辺）を下へスイープする
+	// 接地中は余白 blank だけ浮いているので、誤差を見込んでその2倍まで探す
+	const Vector3 positionAhead = body.position + body.move;
+	const MapChipField::Rect feet = {positionAhead.x - body.width / 2.0f, positionAhead.x + body.width / 2.0f, positionAhead.y - body.height / 2.0f, positionAhead.y - body.height / 2.0f};
+	body.groundBelow = mapChipField_->Sweep(feet, MapChipField::RayDirection::kDown, body.blank * 2.0f).has_value();
+}
+
+// ============================
+// 連続判定
+// ============================
+
+void KinematicBodySystem::ResolveSwept(KinematicBody& body) const {
+
+	const Vector3 halfSize = {body.width / 2.0f, body.height / 2.0f, 0.0f};
+
+	Vector3 position = body.position;
+	Vector3 remaining = body.move;
+
+	for (uint32_t i = 0; i < kMaxSweepIterations && (remaining.x != 0.0f || remaining.y != 0.0f); ++i) {
+
+		const std::optional<MapChipField::SweepHit> hit = mapChipField_->SweepAABB(AABB{position - halfSize, position + halfSize}, remaining);
+		if (!hit) {
+			position += remaining;
+			remaining = {};
+			break;
+		}
+
+		// 接触までは両軸とも進め、当たった軸だけは面の手前 blank で止める（従来の判定と同じ余白）
+		if (hit->normal.x != 0.0f) {
+			const float travel = (std::max)(std::fabs(remaining.x) * hit->time - body.blank, 0.0f);
+			position.x += (remaining.x > 0.0f) ? travel : -travel;
+			position.y += remaining.y * hit->time;
+			remaining = {0.0f, remaining.y * (1.0f - hit->time), 0.0f};
+			body.wallCollision = true;
+		} else {
+			const float travel = (std::max)(std::fabs(remaining.y) * hit->time - body.blank, 0.0f);
+			position.y += (remaining.y > 0.0f) ? travel : -travel;
+			position.x += remaining.x * hit->time;
+			remaining = {remaining.x * (1.0f - hit->time), 0.0f, 0.0f};
+			if (hit->normal.y > 0.0f) {
+				body.floorCollision = true;
+			} else {
+				body.cellingCollision = true;
+			}
+		}
+	}
+
+	// 上限まで滑らせても残った分は捨てる
+	body.move = position - body.position;
+}
+
+// ============================
+// 衝突判定を行う（方向ごとに）
+// ============================
+
+void KinematicBodySystem::ResolveOneSide(KinematicBody& body, HitDir dir, const MapChipField::SolidQuery& query) const {
+	// 方向別の早期 return 条件
+	if (dir == HitDir::kUp && body.move.y <= 0.0f)
+		return; // 上昇時のみ天井判定
+	if (dir == HitDir::kDown && body.move.y >= 0.0f)
+		return; // 下降時のみ床判定
+	if (dir == HitDir::kRight && body.move.x <= 0.0f)
+		return; // 右移動時のみ右壁判定
+	if (dir == HitDir::kLeft && body.move.x >= 0.0f)
+		return; // 左移動時のみ左壁判定
+
+	const float halfWidth = body.width / 2.0f;
+	const float halfHeight = body.height / 2.0f;
+
+	bool hit = false;
+	MapChipField::IndexSet indexSet;
+
+	// 方向ごとに「見る辺（2つの角）」「隣セル方向」を切り替え、辺全体をビットグリッドでまとめて判定する
+	// 角のセルは QuerySolids で求めた範囲の角をそのまま使う
+	auto testEdge = [&](const MapChipField::IndexSet& indexA, const MapChipField::IndexSet& indexB, int dx, int dy) {
+		if (dy != 0) {
+			// 上下の辺：同じ行の [a, b] 列に「隣が空いたブロック」があるか
+			hit = mapChipField_->AnySolidFaceInRow(indexA.yIndex, indexA.xIndex, indexB.xIndex, dy);
+		} else {
+			// 左右の辺：同じ列の [a, b] 行に「隣が空いたブロック」があるか
+			hit = mapChipField_->AnySolidFaceInColumn(indexA.xIndex, indexA.yIndex, indexB.yIndex, dx);
+		}
+	};
+
+	switch (dir) {
+	case HitDir::kUp:
+		// 左上/右上、隣セルは +y（天井）
+		testEdge(query.min, {query.max.xIndex, query.min.yIndex}, 0, +1);
+		if (!hit)
+			return;
+
+		// 「移動後の上端」基準セルを取得して、rect.bottom から詰める（元実装）
+		indexSet = mapChipField_->GetMapChipIndexSetByPosition(body.position + body.move + Vector3(0.0f, -halfHeight + body.blank, 0.0f));
+		// 直前セルの yIndex と違うときだけ当て込む（揺れ防止の元ロジック）
+		{
+			MapChipField::IndexSet now = mapChipField_->GetMapChipIndexSetByPosition(body.position + Vector3(0.0f, halfHeight + body.blank, 0.0f));
+			if (now.yIndex != indexSet.yIndex) {
+				MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
+				float moveY = (rect.bottom - body.position.y) - (halfHeight + body.blank);
+				body.move.y = (std::max)(0.0f, moveY); // 上方向は正に詰める
+				body.cellingCollision = true;
+			}
+		}
+		break;
+
+	case HitDir::kDown:
+		// 左下/右下、隣セルは -y（床）
+		testEdge({query.min.xIndex, query.max.yIndex}, query.max, 0, -1);
+		if (!hit)
+			return;
+
+		// 左下のセルを起点に、直前セル yIndex 変化を見て rect.top から詰める（元実装）
+		indexSet = {query.min.xIndex, query.max.yIndex};
+		{
+			MapChipField::IndexSet now = mapChipField_->GetMapChipIndexSetByPosition(body.position - Vector3(0.0f, halfHeight, 0.0f));
+			if (now.yIndex != indexSet.yIndex) {
+				MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
+				float moveY = (rect.top - body.position.y) + (halfHeight + body.blank);
+				body.move.y = (std::min)(0.0f, moveY); // 下方向は負に詰める
+				body.floorCollision = true;
+			}
+		}
+		break;
+
+	case HitDir::kRight:
+		// 右下/右上、隣セルは x-1（ブロック左端と接触で詰め）
+		testEdge(query.max, {query.max.xIndex, query.min.yIndex}, -1, 0);
+		if (!hit)
+			return;
+
+		indexSet = mapChipField_->GetMapChipIndexSetByPosition(body.position + body.move + Vector3(halfWidth + body.blank, 0.0f, 0.0f));
+		{
+			MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
+			float moveX = (rect.left - body.position.x) - (halfWidth + body.blank);
+			body.move.x = (std::max)(0.0f, moveX); // 右方向は正に詰める
+			body.wallCollision = true;
+		}
+		break;
+
+	case HitDir::kLeft:
+		// 左下/左上、隣セルは x+1（ブロック右端と接触で詰め）
+		testEdge({query.min.xIndex, query.max.yIndex}, query.min, +1, 0);
+		if (!hit)
+			return;
+
+		indexSet = mapChipField_->GetMapChipIndexSetByPosition(body.position + body.move - Vector3(halfWidth + body.blank, 0.0f, 0.0f));
+		{
+			MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
+			float moveX = (rect.right - body.position.x) + (halfWidth + body.blank);
+			body.move.x = (std::min)(0.0f, moveX); // 左方向は負に詰める
+			body.wallCollision = true;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "../MapChipField/MapChipField.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+class JobSystem;
+
+// マップと当たり判定をする箱（Player・Enemy 共通）
+struct KinematicBody {
+	enum Corner {
+		kRightBottom, // 右下
+		kLeftBottom,  // 左下
+		kRightTop,    // 右上
+		kLeftTop,     // 左上
+		kNumCorner    // 要素数
+	};
+
+	// 当たり判定サイズと余白
+	float width = 0.0f;
+	float height = 0.0f;
+	float blank = 0.0f;
+
+	// 中心座標（解決後は移動済みの位置）
+	Vector3 position = {};
+	// 今フレームの移動量（解決後はブロックで詰めた値）
+	Vector3 move = {};
+
+	// 解決結果
+	bool cellingCollision = false; // 天井衝突フラグ
+	bool floorCollision = false;   // 床衝突フラグ
+	bool wallCollision = false;    // 壁衝突フラグ
+	bool groundBelow = false;      // 足元に床があるか（接地の切り替え用）
+
+	bool pending = false; // 今フレームの解決待ちか
+	bool alive = false;   // スロットが使われているか
+
+	Vector3 CornerPosition(const Vector3& center, Corner corner) const;
+};
+
+// 全キャラクターのボディを連続した配列で持ち、マップとの当たり判定を1フレーム1回まとめて解く
+class KinematicBodySystem {
+public:
+	using BodyId = uint32_t;
+
+	void SetMapChipField(const MapChipField* mapChipField) { mapChipField_ = mapChipField; }
+
+	// 設定するとボディを分けて並列に解く（nullptr なら順番に解く。結果はどちらも同じ）
+	void SetJobSystem(JobSystem* jobSystem) { jobSystem_ = jobSystem; }
+
+	BodyId Create(float width, float height, float blank);
+	void Destroy(BodyId id);
+
+	KinematicBody& Get(BodyId id) { return bodies_[id]; }
+	const KinematicBody& Get(BodyId id) const { return bodies_[id]; }
+
+	// 今フレームの位置と移動量を渡して解決待ちにする
+	void Submit(BodyId id, const Vector3& position, const Vector3& move);
+
+	// 解決待ちのボディをすべてマップと解決する
+	void ResolveMapCollisions();
+
+private:
+	// 方向を表す
+	enum HitDir { kUp, kDown, kRight, kLeft, kCount };
+
+	// 1フレームの移動がどちらの軸もこれ以下なら、移動後の角で調べる従来の判定で十分（ブロックを飛び越えない）
+	static inline const float kDiscreteMoveLimit = 1.0f;
+	// 連続判定で、当たった面に沿って滑らせ直す回数の上限（角に当たっても2回で止まる）
+	static inline const uint32_t kMaxSweepIterations = 2;
+
+	// 並列に解くとき、1つのジョブで受け持つボディ数
+	static inline const uint32_t kResolveGrainSize = 32;
+
+	const MapChipField* mapChipField_ = nullptr;
+	JobSystem* jobSystem_ = nullptr;
+
+	std::vector<KinematicBody> bodies_;
+	std::vector<BodyId> freeIds_; // 空いているスロット
+
+	void Resolve(KinematicBody& body) const;
+	// 移動が大きいとき用の連続判定（最初に当たる面の手前で止め、残りを面に沿って動かす）
+	void ResolveSwept(KinematicBody& body) const;
+	// 1方向ぶんの当たり判定（角のセルは query の範囲をそのまま使う）
+	void ResolveOneSide(KinematicBody& body, HitDir dir, const MapChipField::SolidQuery& query) const;
+};
@@ -1,127 +1,472 @@
 #include "MapChipField.h"
+#include <Windows.h>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <limits>
+#ifdef _DEBUG
+#include <chrono>
 #include <map>
+#include <random>
 #include <sstream>
+#endif // _DEBUG
 
 namespace {
-std::map<std::string, MapChipType> mapChipTable = {
-    {"0", MapChipType::kAir  },
-    {"1", MapChipType::kBlock},
+// CSVの1文字セルの種類
+enum class CellToken : uint8_t {
+	kUnknown,
+	kAir,
+	kBlock,
+	kPlayer,
+	kEnemy,
+	kCoin,
+	kGoal,
 };
+
+// 文字 → セル種類の表（文字列の比較や map の検索をしない）
+constexpr std::array<CellToken, 256> kCellTokenTable = [] {
+	std::array<CellToken, 256> table{};
+	table['0'] = CellToken::kAir;
+	table['1'] = CellToken::kBlock;
+	table['p'] = table['P'] = CellToken::kPlayer;
+	table['e'] = table['E'] = CellToken::kEnemy;
+	table['c'] = table['C'] = CellToken::kCoin;
+	table['g'] = table['G'] = CellToken::kGoal;
+	return table;
+}();
+
+// [cursor, end) から次の1行を切り出す。contentEnd は行末の CR/LF を除いた位置
+const char* NextLine(const char* cursor, const char* end, const char*& contentEnd) {
+	const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+	if (!lineEnd) {
+		lineEnd = end;
+	}
+	contentEnd = lineEnd;
+	if (contentEnd > cursor && contentEnd[-1] == '\r') {
+		--contentEnd;
+	}
+	return (lineEnd < end) ? lineEnd + 1 : end;
 }
 
-void MapChipField::ResetMapChipData() {
+// [begin, end] を符号付きとして解釈して 0..size-1 に収める（負の座標からの折り返し対策）
+bool ClampSpan(uint32_t& begin, uint32_t& end, uint32_t size) {
+	int64_t b = static_cast<int32_t>(begin);
+	int64_t e = static_cast<int32_t>(end);
+	if (b > e) {
+		std::swap(b, e);
+	}
+	b = (std::max)(b, int64_t{0});
+	e = (std::min)(e, static_cast<int64_t>(size) - 1);
+	if (b > e) {
+		return false;
+	}
+	begin = static_cast<uint32_t>(b);
+	end = static_cast<uint32_t>(e);
+	return true;
+}
 
-	mapChipData_.data.clear();
-	mapChipData_.data.resize(kNumBlockVirtical);
+// ビット範囲 [begin, end] を 64bit 単位で走査し、ワードごとのマスクを fn に渡す
+template <typename Fn> void ForEachSpanWord(uint32_t begin, uint32_t end, Fn fn) {
+	const uint32_t firstWord = begin >> 6;
+	const uint32_t lastWord = end >> 6;
+	for (uint32_t w = firstWord; w <= lastWord; ++w) {
+		uint64_t mask = ~uint64_t{0};
+		if (w == firstWord) {
+			mask &= ~uint64_t{0} << (begin & 63);
+		}
+		if (w == lastWord) {
+			mask &= ~uint64_t{0} >> (63 - (end & 63));
+		}
+		if (fn(w, mask)) {
+			return;
+		}
+	}
+}
 
-	for (std::vector<MapChipType>& mapChipDaraLine : mapChipData_.data) {
-		mapChipDaraLine.resize(kNumBlockHorizontal);
+// ForEachSpanWord の逆順（end 側のワードから begin 側へ）
+template <typename Fn> void ForEachSpanWordReverse(uint32_t begin, uint32_t end, Fn fn) {
+	const uint32_t firstWord = begin >> 6;
+	const uint32_t lastWord = end >> 6;
+	for (uint32_t w = lastWord + 1; w-- > firstWord;) {
+		uint64_t mask = ~uint64_t{0};
+		if (w == firstWord) {
+			mask &= ~uint64_t{0} << (begin & 63);
+		}
+		if (w == lastWord) {
+			mask &= ~uint64_t{0} >> (63 - (end & 63));
+		}
+		if (fn(w, mask)) {
+			return;
+		}
 	}
+}
+} // namespace
+
+MapChipField::~MapChipField() {
+	StopStreamThread();
+	ReleaseAllChunks();
+}
+
+void MapChipField::ResetMapChipData() {
+
+	// 読み込みスレッドが古いタイルを読まないよう先に止める
+	StopStreamThread();
+	ReleaseAllChunks();
+
+	mapChipData_.data = {};
+	mapChipData_.storage.clear();
+	stageBinary_.Close();
+	mapChipData_.numBlockVirtical = 0;
+	mapChipData_.numBlockHorizontal = 0;
+
+	loadedBytes_ = 0;
+	loadError_.clear();
 
 	playerSpawnIndex_.reset();
 	enemySpawnIndices_.clear();
 	coinSpawnIndices_.clear();
+	goalSpawnIndices_.clear();
+
+	solidWordsPerRow_ = 0;
+	solidWordsPerColumn_ = 0;
+	solidRowBits_.clear();
+	solidColumnBits_.clear();
+
 }
 
-void MapChipField::LoadMapChipCSV(const std::string& filePath) {
+bool MapChipField::LoadMapChipCSV(const std::string& filePath) {
 
 	ResetMapChipData();
 
-	std::ifstream file;
-	file.open(filePath);
-	assert(file.is_open());
+	// ファイル全体を1つのバッファに読み込み、そこから直接解析する
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) {
+		return ReportLoadError(filePath + ": cannot open map chip CSV.");
+	}
+	const std::streamsize fileSize = file.tellg();
+	file.seekg(0);
 
-	std::stringstream mapChipCSV;
-	// ファイルの内容を文字列ストリームに読み込む
-	mapChipCSV << file.rdbuf();
-	// ファイルを閉じる
+	std::vector<char> buffer(static_cast<size_t>((std::max)(fileSize, std::streamsize{0})));
+	file.read(buffer.data(), fileSize);
 	file.close();
 
-	for (uint32_t i = 0; i < kNumBlockVirtical; ++i) {
-		std::string line;
-		std::getline(mapChipCSV, line);
+	return LoadMapChipCSVText(buffer.data(), buffer.size(), filePath);
+}
 
-		// 1行分の文字列をストリームに変換して解析しやすくする
-		std::istringstream line_stream(line);
+bool MapChipField::LoadMapChipCSVText(const char* text, size_t size, const std::string& sourceName) {
 
-		for (uint32_t j = 0; j < kNumBlockHorizontal; ++j) {
-			std::string word;
-			getline(line_stream, word, ',');
+	ResetMapChipData();
+	loadedBytes_ = size;
 
-			if (word == "p" || word == "P") {
-				playerSpawnIndex_ = IndexSet{j, i};
-				mapChipData_.data[i][j] = MapChipType::kAir; // スポーンは空扱い
-				continue;
-			} else if (word == "e" || word == "E") {
-				enemySpawnIndices_.push_back(IndexSet{j, i});
-				mapChipData_.data[i][j] = MapChipType::kAir; // スポーンは空扱い
-				continue;
-			} else if (word == "c" || word == "C") {
+	if (!ParseMapChipCSV(text, size, sourceName)) {
+		return false;
+	}
+	BuildSolidBits();
+	return true;
+}
+
+bool MapChipField::ParseMapChipCSV(const char* text, size_t size, const std::string& sourceName) {
+
+	const char* const end = text + size;
+	const char* begin = text;
+	// UTF-8 の BOM は読み飛ばす
+	if (size >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) {
+		begin += 3;
+	}
+
+	// 1パス目：空でない行の数（縦のブロック数）と先頭行のセル数（横のブロック数）を数える
+	uint32_t numVertical = 0;
+	uint32_t numHorizontal = 0;
+	for (const char* cursor = begin; cursor < end;) {
+		const char* contentEnd = nullptr;
+		const char* next = NextLine(cursor, end, contentEnd);
+		if (contentEnd > cursor) {
+			if (numVertical == 0) {
+				numHorizontal = static_cast<uint32_t>(std::count(cursor, contentEnd, ',')) + 1;
+			}
+			++numVertical;
+		}
+		cursor = next;
+	}
+	if (numVertical == 0) {
+		return ReportLoadError(sourceName + ": map chip CSV is empty.");
+	}
+
+	mapChipData_.numBlockVirtical = numVertical;
+	mapChipData_.numBlockHorizontal = numHorizontal;
+	mapChipData_.storage.assign(static_cast<size_t>(numVertical) * numHorizontal, MapChipType::kAir);
+	mapChipData_.data = mapChipData_.storage;
+
+	// 2パス目：セルを1文字ずつ解析する
+	uint32_t i = 0;
+	uint32_t lineNumber = 0; // エラー表示用（ファイル上の行番号）
+	for (const char* cursor = begin; cursor < end;) {
+		const char* contentEnd = nullptr;
+		const char* next = NextLine(cursor, end, contentEnd);
+		++lineNumber;
+
+		if (contentEnd == cursor) {
+			cursor = next;
+			continue;
+		}
+
+		MapChipType* row = &mapChipData_.storage[static_cast<size_t>(i) * numHorizontal];
+
+		uint32_t j = 0;
+		for (const char* cell = cursor;; ++j) {
+			const char* cellEnd = cell;
+			while (cellEnd < contentEnd && *cellEnd != ',') {
+				++cellEnd;
+			}
+
+			if (j >= numHorizontal) {
+				return ReportLoadError(sourceName + "(" + std::to_string(lineNumber) + "," + std::to_string(j + 1) + "): row has more than " + std::to_string(numHorizontal) + " cells.");
+			}
+
+			const CellToken token = (cellEnd - cell == 1) ? kCellTokenTable[static_cast<uint8_t>(*cell)] : CellToken::kUnknown;
+			switch (token) {
+			case CellToken::kAir:
+				row[j] = MapChipType::kAir;
+				break;
+			case CellToken::kBlock:
+				row[j] = MapChipType::kBlock;
+				break;
+			case CellToken::kPlayer:
+				playerSpawnIndex_ = IndexSet{j, i}; // スポーンは空扱い
+				break;
+			case CellToken::kEnemy:
+				enemySpawnIndices_.push_back(IndexSet{j, i}); // スポーンは空扱い
+				break;
+			case CellToken::kCoin:
 				coinSpawnIndices_.push_back(IndexSet{j, i});
-				mapChipData_.data[i][j] = MapChipType::kAir;
-				continue;
-			} else if (word == "g" || word == "G") {
+				break;
+			case CellToken::kGoal:
 				goalSpawnIndices_.push_back(IndexSet{j, i});
-				continue;
+				break;
+			default:
+				return ReportLoadError(sourceName + "(" + std::to_string(lineNumber) + "," + std::to_string(j + 1) + "): unknown map chip \"" + std::string(cell, cellEnd) + "\".");
 			}
 
-			// 既存の "0"/"1" ルックアップ（未知は assert
-			if (mapChipTable.contains(word)) {
-				mapChipData_.data[i][j] = mapChipTable[word];
-			} else {
-				assert(false && "Unknown map chip type in CSV file.");
+			if (cellEnd == contentEnd) {
+				break;
 			}
+			cell = cellEnd + 1;
+		}
+
+		if (j + 1 != numHorizontal) {
+			return ReportLoadError(sourceName + "(" + std::to_string(lineNumber) + "," + std::to_string(j + 2) + "): row has fewer than " + std::to_string(numHorizontal) + " cells.");
 		}
+
+		++i;
+		cursor = next;
 	}
+
+	return true;
 }
 
-MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) {
+bool MapChipField::ReportLoadError(const std::string& message) {
+	// 途中まで読んだデータは残さない
+	ResetMapChipData();
+	loadError_ = message;
+	// Visual Studio の出力ウィンドウに行・列つきで表示する
+	OutputDebugStringA((message + "\n").c_str());
+	return false;
+}
 
-	if (xIndex < 0 || kNumBlockHorizontal - 1 < xIndex) {
-		return MapChipType::kAir;
+bool MapChipField::LoadMapChipBinary(const std::string& filePath) {
+
+	ResetMapChipData();
+
+	if (!stageBinary_.Open(filePath)) {
+		return false;
 	}
-	if (yIndex < 0 || kNumBlockVirtical - 1 < yIndex) {
-		return MapChipType::kAir;
+	loadedBytes_ = stageBinary_.GetHeader().fileSize;
+
+	const StageBinary::Header& header = stageBinary_.GetHeader();
+	mapChipData_.numBlockVirtical = header.numBlockVirtical;
+	mapChipData_.numBlockHorizontal = header.numBlockHorizontal;
+
+	// タイルはマップしたファイルを直接参照する
+	static_assert(sizeof(MapChipType) == sizeof(uint8_t));
+	const std::span<const uint8_t> tiles = stageBinary_.GetTiles();
+	mapChipData_.data = {reinterpret_cast<const MapChipType*>(tiles.data()), tiles.size()};
+
+	if (header.hasPlayerSpawn) {
+		playerSpawnIndex_ = IndexSet{header.playerSpawn.xIndex, header.playerSpawn.yIndex};
+	}
+	for (const StageSpawnIndex& idx : stageBinary_.GetEnemySpawns()) {
+		enemySpawnIndices_.push_back(IndexSet{idx.xIndex, idx.yIndex});
+	}
+	for (const StageSpawnIndex& idx : stageBinary_.GetCoinSpawns()) {
+		coinSpawnIndices_.push_back(IndexSet{idx.xIndex, idx.yIndex});
+	}
+	for (const StageSpawnIndex& idx : stageBinary_.GetGoalSpawns()) {
+		goalSpawnIndices_.push_back(IndexSet{idx.xIndex, idx.yIndex});
 	}
 
-	return mapChipData_.data[yIndex][xIndex];
+	BuildSolidBits();
+	return true;
 }
 
-Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) { return Vector3(kBlockWidth * xIndex, kBlockHeight * (kNumBlockVirtical - 1 - yIndex), 0); }
+bool MapChipField::LoadStage(const std::string& csvPath) {
 
-void MapChipField::GenerateBlocks() {
-	// 既存のブロックを解放
-	for (auto& line : worldTransformBlocks_) {
-		for (auto* block : line) {
-			delete block;
+	std::filesystem::path binaryPath = csvPath;
+	binaryPath.replace_extension(".stage");
+
+	// 通常はビルド後イベントで変換済み。CSVより新しいバイナリだけを使う
+	std::error_code ec;
+	const bool exists = std::filesystem::exists(binaryPath, ec);
+	if (exists && std::filesystem::last_write_time(binaryPath, ec) >= std::filesystem::last_write_time(csvPath, ec)) {
+		if (LoadMapChipBinary(binaryPath.string())) {
+			return true;
 		}
+		// 版の更新やチェックサム不一致で通らないバイナリは消し、毎回検証し直さないようにする
+		std::filesystem::remove(binaryPath, ec);
 	}
-	worldTransformBlocks_.clear();
 
-	const uint32_t numVertical = static_cast<uint32_t>(mapChipData_.data.size());
-	const uint32_t numHorizontal = numVertical > 0 ? static_cast<uint32_t>(mapChipData_.data[0].size()) : 0;
+	// CSVは1回だけ読む。誤りがあればエラー内容を残して false
+	if (!LoadMapChipCSV(csvPath)) {
+		return false;
+	}
 
-	worldTransformBlocks_.resize(numVertical);
-	for (uint32_t i = 0; i < numVertical; ++i) {
-		worldTransformBlocks_[i].resize(numHorizontal, nullptr);
-		for (uint32_t j = 0; j < numHorizontal; ++j) {
-			MapChipType mapChipType = GetMapChipTypeByIndex(j, i);
-			if (mapChipType == MapChipType::kBlock) { // ブロックの場合ブロックを描画
-				// 位置を取得
-				Vector3 position = GetMapChipPositionByIndex(j, i);
-				// ワールドトランスフォームを生成
-				WorldTransform* worldTransform = new WorldTransform();
-				worldTransform->Initialize();
-				worldTransform->translation_ = position;
-				worldTransformBlocks_[i][j] = worldTransform;
+	// 読み込んだ内容からバイナリを作り直す（書き込めなくてもCSVの結果をそのまま使う）
+	StageBinary::Write(binaryPath.string(), *this);
+	return true;
+}
+
+#ifdef _DEBUG
+// ============================
+// CSV読み込みのベンチマーク
+// ============================
+
+namespace {
+// 比較用に残した旧ローダー（1行ずつ std::string に切り出し、セルごとに std::map を引く）
+struct ReferenceCsvResult {
+	std::vector<MapChipType> tiles;
+	size_t spawnCount = 0;
+};
+
+ReferenceCsvResult LoadMapChipCSVReference(const std::string& text) {
+
+	static const std::map<std::string, MapChipType> mapChipTable = {
+	    {"0", MapChipType::kAir  },
+	    {"1", MapChipType::kBlock},
+	};
+
+	std::stringstream mapChipCSV;
+	mapChipCSV << text;
+
+	std::vector<std::string> lines;
+	std::string line;
+	while (std::getline(mapChipCSV, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (!line.empty()) {
+			lines.push_back(line);
+		}
+	}
+
+	ReferenceCsvResult result;
+	if (lines.empty()) {
+		return result;
+	}
+	const size_t numHorizontal = static_cast<size_t>(std::count(lines[0].begin(), lines[0].end(), ',')) + 1;
+	result.tiles.assign(lines.size() * numHorizontal, MapChipType::kAir);
+
+	for (size_t i = 0; i < lines.size(); ++i) {
+		std::istringstream line_stream(lines[i]);
+		for (size_t j = 0; j < numHorizontal; ++j) {
+			std::string word;
+			getline(line_stream, word, ',');
+
+			if (word == "p" || word == "P" || word == "e" || word == "E" || word == "c" || word == "C" || word == "g" || word == "G") {
+				++result.spawnCount;
+				continue;
 			}
+			const auto it = mapChipTable.find(word);
+			if (it != mapChipTable.end()) {
+				result.tiles[i * numHorizontal + j] = it->second;
+			}
+		}
+	}
+	return result;
+}
+} // namespace
+
+CsvLoadBenchmark RunCsvLoadBenchmark(uint32_t numRows, uint32_t numColumns) {
+
+	// ブロックと空白を半々くらいに、ときどき敵・コインを混ぜる（乱数は固定）
+	std::mt19937 random(12345);
+	std::uniform_int_distribution<int> cellKind(0, 99);
+	std::string text;
+	text.reserve(static_cast<size_t>(numRows) * numColumns * 2);
+	for (uint32_t i = 0; i < numRows; ++i) {
+		for (uint32_t j = 0; j < numColumns; ++j) {
+			const int kind = cellKind(random);
+			text += (kind < 48) ? '1' : (kind < 97) ? '0' : (kind < 98) ? 'e' : 'c';
+			text += (j + 1 < numColumns) ? ',' : '\n';
 		}
 	}
+
+	CsvLoadBenchmark result;
+	result.numRows = numRows;
+	result.numColumns = numColumns;
+	result.byteSize = text.size();
+
+	// 何回か読んで一番速かった回を使う
+	static const int kRepeatCount = 3;
+	const double megaBytes = static_cast<double>(text.size()) / (1024.0 * 1024.0);
+	auto megaBytesPerSecond = [&](std::chrono::steady_clock::duration elapsed) { return megaBytes / std::chrono::duration<double>(elapsed).count(); };
+
+	ReferenceCsvResult reference;
+	for (int r = 0; r < kRepeatCount; ++r) {
+		const auto begin = std::chrono::steady_clock::now();
+		reference = LoadMapChipCSVReference(text);
+		result.referenceMegaBytesPerSecond = (std::max)(result.referenceMegaBytesPerSecond, megaBytesPerSecond(std::chrono::steady_clock::now() - begin));
+	}
+
+	MapChipField field;
+	bool loaded = false;
+	for (int r = 0; r < kRepeatCount; ++r) {
+		const auto begin = std::chrono::steady_clock::now();
+		loaded = field.LoadMapChipCSVText(text.data(), text.size(), "benchmark");
+		result.scannerMegaBytesPerSecond = (std::max)(result.scannerMegaBytesPerSecond, megaBytesPerSecond(std::chrono::steady_clock::now() - begin));
+	}
+
+	const size_t spawnCount = field.GetEnemySpawnIndices().size() + field.GetCoinSpawnIndices().size();
+	result.resultsMatch = loaded && spawnCount == reference.spawnCount && std::equal(field.mapChipData_.data.begin(), field.mapChipData_.data.end(), reference.tiles.begin(), reference.tiles.end());
+	return result;
+}
+#endif // _DEBUG
+
+MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const {
+
+	// 範囲外（負の添字の折り返しを含む）は空扱い
+	if (xIndex >= mapChipData_.numBlockHorizontal || yIndex >= mapChipData_.numBlockVirtical) {
+		return MapChipType::kAir;
+	}
+
+	return mapChipData_.data[static_cast<size_t>(yIndex) * mapChipData_.numBlockHorizontal + xIndex];
+}
+
+Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) const {
+	return Vector3(kBlockWidth * xIndex, kBlockHeight * (mapChipData_.numBlockVirtical - 1 - yIndex), 0);
 }
 
-MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3& position) {
+void MapChipField::GenerateBlocks() {
+	// 既存のチャンクを捨て、読み込みスレッドを作り直す
+	StopStreamThread();
+	ReleaseAllChunks();
+	StartStreamThread();
+}
+
+MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3& position) const {
 
 	IndexSet indexSet = {};
 
@@ -132,12 +477,12 @@ MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3&
 	indexSetTemp.yIndex = static_cast<uint32_t>((position.y + kBlockHeight / 2) / kBlockHeight);
 
 	// 反転後のy座標を計算
-	indexSet.yIndex = static_cast<uint32_t>(kNumBlockVirtical - 1 - indexSetTemp.yIndex);
+	indexSet.yIndex = static_cast<uint32_t>(mapChipData_.numBlockVirtical - 1 - indexSetTemp.yIndex);
 
 	return indexSet;
 }
 
-MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex) {
+MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const {
 
 	Vector3 center = GetMapChipPositionByIndex(xIndex, yIndex);
 
@@ -150,3 +495,561 @@ MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex
 
 	return rect;
 }
+
+// ============================
+// ビットグリッド
+// ============================
+
+void MapChipField::BuildSolidBits() {
+
+	const uint32_t numVertical = mapChipData_.numBlockVirtical;
+	const uint32_t numHorizontal = mapChipData_.numBlockHorizontal;
+
+	solidWordsPerRow_ = (numHorizontal + 63) / 64;
+	solidWordsPerColumn_ = (numVertical + 63) / 64;
+	solidRowBits_.assign(static_cast<size_t>(numVertical) * solidWordsPerRow_, 0);
+	solidColumnBits_.assign(static_cast<size_t>(numHorizontal) * solidWordsPerColumn_, 0);
+
+	for (uint32_t i = 0; i < numVertical; ++i) {
+		for (uint32_t j = 0; j < numHorizontal; ++j) {
+			if (mapChipData_.data[static_cast<size_t>(i) * numHorizontal + j] != MapChipType::kBlock) {
+				continue;
+			}
+			solidRowBits_[static_cast<size_t>(i) * solidWordsPerRow_ + (j >> 6)] |= uint64_t{1} << (j & 63);
+			solidColumnBits_[static_cast<size_t>(j) * solidWordsPerColumn_ + (i >> 6)] |= uint64_t{1} << (i & 63);
+		}
+	}
+}
+
+uint64_t MapChipField::SolidRowWord(uint32_t yIndex, uint32_t word) const {
+	if (yIndex >= mapChipData_.numBlockVirtical) {
+		return 0;
+	}
+	return solidRowBits_[static_cast<size_t>(yIndex) * solidWordsPerRow_ + word];
+}
+
+uint64_t MapChipField::SolidColumnWord(uint32_t xIndex, uint32_t word) const {
+	if (xIndex >= mapChipData_.numBlockHorizontal) {
+		return 0;
+	}
+	return solidColumnBits_[static_cast<size_t>(xIndex) * solidWordsPerColumn_ + word];
+}
+
+bool MapChipField::IsSolid(uint32_t xIndex, uint32_t yIndex) const {
+	if (xIndex >= mapChipData_.numBlockHorizontal) {
+		return false;
+	}
+	return ((SolidRowWord(yIndex, xIndex >> 6) >> (xIndex & 63)) & 1) != 0;
+}
+
+bool MapChipField::AnySolidInRow(uint32_t yIndex, uint32_t xBegin, uint32_t xEnd) const {
+	if (yIndex >= mapChipData_.numBlockVirtical || !ClampSpan(xBegin, xEnd, mapChipData_.numBlockHorizontal)) {
+		return false;
+	}
+	bool found = false;
+	ForEachSpanWord(xBegin, xEnd, [&](uint32_t w, uint64_t mask) {
+		found = (SolidRowWord(yIndex, w) & mask) != 0;
+		return found;
+	});
+	return found;
+}
+
+bool MapChipField::AnySolidInColumn(uint32_t xIndex, uint32_t yBegin, uint32_t yEnd) const {
+	if (xIndex >= mapChipData_.numBlockHorizontal || !ClampSpan(yBegin, yEnd, mapChipData_.numBlockVirtical)) {
+		return false;
+	}
+	bool found = false;
+	ForEachSpanWord(yBegin, yEnd, [&](uint32_t w, uint64_t mask) {
+		found = (SolidColumnWord(xIndex, w) & mask) != 0;
+		return found;
+	});
+	return found;
+}
+
+uint32_t MapChipField::CountSolidInRow(uint32_t yIndex, uint32_t xBegin, uint32_t xEnd) const {
+	if (yIndex >= mapChipData_.numBlockVirtical || !ClampSpan(xBegin, xEnd, mapChipData_.numBlockHorizontal)) {
+		return 0;
+	}
+	uint32_t count = 0;
+	ForEachSpanWord(xBegin, xEnd, [&](uint32_t w, uint64_t mask) {
+		count += static_cast<uint32_t>(std::popcount(SolidRowWord(yIndex, w) & mask));
+		return false;
+	});
+	return count;
+}
+
+std::optional<uint32_t> MapChipField::FindFirstSolid(uint32_t xIndex, uint32_t yIndex, RayDirection direction) const {
+	if (xIndex >= mapChipData_.numBlockHorizontal || yIndex >= mapChipData_.numBlockVirtical) {
+		return std::nullopt;
+	}
+
+	// 左右は行のワード、上下は列のワードを、進む向きに 64 マスずつ調べる（どちらも下位ビットほど添字が小さい）
+	const bool vertical = (direction == RayDirection::kUp || direction == RayDirection::kDown);
+	const uint32_t line = vertical ? xIndex : yIndex;
+	const uint32_t position = vertical ? yIndex : xIndex;
+	auto wordAt = [&](uint32_t w) { return vertical ? SolidColumnWord(line, w) : SolidRowWord(line, w); };
+
+	std::optional<uint32_t> result;
+	if (direction == RayDirection::kRight || direction == RayDirection::kDown) {
+		// 添字が増える向き：[position, 端] で最下位の立ちビット
+		const uint32_t last = (vertical ? mapChipData_.numBlockVirtical : mapChipData_.numBlockHorizontal) - 1;
+		ForEachSpanWord(position, last, [&](uint32_t w, uint64_t mask) {
+			const uint64_t bits = wordAt(w) & mask;
+			if (bits != 0) {
+				result = w * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+			}
+			return result.has_value();
+		});
+	} else {
+		// 添字が減る向き：[0, position] で最上位の立ちビット
+		ForEachSpanWordReverse(0, position, [&](uint32_t w, uint64_t mask) {
+			const uint64_t bits = wordAt(w) & mask;
+			if (bits != 0) {
+				result = w * 64 + 63 - static_cast<uint32_t>(std::countl_zero(bits));
+			}
+			return result.has_value();
+		});
+	}
+	return result;
+}
+
+bool MapChipField::AnySolidFaceInRow(uint32_t yIndex, uint32_t xBegin, uint32_t xEnd, int32_t dy) const {
+	if (yIndex >= mapChipData_.numBlockVirtical || !ClampSpan(xBegin, xEnd, mapChipData_.numBlockHorizontal)) {
+		return false;
+	}
+	const uint32_t neighborY = yIndex + static_cast<uint32_t>(dy); // 範囲外は SolidRowWord が 0 を返す
+	bool found = false;
+	ForEachSpanWord(xBegin, xEnd, [&](uint32_t w, uint64_t mask) {
+		found = (SolidRowWord(yIndex, w) & ~SolidRowWord(neighborY, w) & mask) != 0;
+		return found;
+	});
+	return found;
+}
+
+bool MapChipField::AnySolidFaceInColumn(uint32_t xIndex, uint32_t yBegin, uint32_t yEnd, int32_t dx) const {
+	if (xIndex >= mapChipData_.numBlockHorizontal || !ClampSpan(yBegin, yEnd, mapChipData_.numBlockVirtical)) {
+		return false;
+	}
+	const uint32_t neighborX = xIndex + static_cast<uint32_t>(dx);
+	bool found = false;
+	ForEachSpanWord(yBegin, yEnd, [&](uint32_t w, uint64_t mask) {
+		found = (SolidColumnWord(xIndex, w) & ~SolidColumnWord(neighborX, w) & mask) != 0;
+		return found;
+	});
+	return found;
+}
+
+MapChipField::SolidQuery MapChipField::QuerySolids(const AABB& aabb) const {
+
+	SolidQuery query;
+	query.field_ = this;
+	// 左上と右下の角から、範囲を一度だけ求める
+	const IndexSet topLeft = GetMapChipIndexSetByPosition(Vector3(aabb.min.x, aabb.max.y, 0.0f));
+	const IndexSet bottomRight = GetMapChipIndexSetByPosition(Vector3(aabb.max.x, aabb.min.y, 0.0f));
+	query.min = topLeft;
+	query.max = bottomRight;
+
+	query.xBegin_ = topLeft.xIndex;
+	query.xEnd_ = bottomRight.xIndex;
+	query.yBegin_ = topLeft.yIndex;
+	query.yEnd_ = bottomRight.yIndex;
+	query.valid_ = ClampSpan(query.xBegin_, query.xEnd_, mapChipData_.numBlockHorizontal) && ClampSpan(query.yBegin_, query.yEnd_, mapChipData_.numBlockVirtical);
+
+	return query;
+}
+
+MapChipField::SolidQuery::Iterator MapChipField::SolidQuery::begin() const {
+	Iterator it;
+	it.query_ = this;
+	if (valid_) {
+		it.Seek(xBegin_, yBegin_);
+	}
+	return it;
+}
+
+MapChipField::SolidQuery::Iterator& MapChipField::SolidQuery::Iterator::operator++() {
+	if (current_.xIndex < query_->xEnd_) {
+		Seek(current_.xIndex + 1, current_.yIndex);
+	} else {
+		Seek(query_->xBegin_, current_.yIndex + 1);
+	}
+	return *this;
+}
+
+void MapChipField::SolidQuery::Iterator::Seek(uint32_t xIndex, uint32_t yIndex) {
+	done_ = true;
+	for (; yIndex <= query_->yEnd_; ++yIndex, xIndex = query_->xBegin_) {
+		bool found = false;
+		ForEachSpanWord(xIndex, query_->xEnd_, [&](uint32_t w, uint64_t mask) {
+			const uint64_t bits = query_->field_->SolidRowWord(yIndex, w) & mask;
+			if (bits == 0) {
+				return false;
+			}
+			current_ = IndexSet{w * 64 + static_cast<uint32_t>(std::countr_zero(bits)), yIndex};
+			found = true;
+			return true;
+		});
+		if (found) {
+			done_ = false;
+			return;
+		}
+	}
+}
+
+// ============================
+// レイキャスト
+// ============================
+
+std::optional<float> MapChipField::Sweep(const Rect& box, RayDirection direction, float maxDistance) const {
+
+	const int64_t numVertical = mapChipData_.numBlockVirtical;
+	const int64_t numHorizontal = mapChipData_.numBlockHorizontal;
+	if (numVertical == 0 || numHorizontal == 0) {
+		return std::nullopt;
+	}
+
+	// ワールド座標 → 符号付きの添字（マップ外も表せるように）
+	auto columnOf = [](float x) { return static_cast<int64_t>(std::floor((x + kBlockWidth / 2) / kBlockWidth)); };
+	auto rowOf = [&](float y) { return numVertical - 1 - static_cast<int64_t>(std::floor((y + kBlockHeight / 2) / kBlockHeight)); };
+
+	const bool vertical = (direction == RayDirection::kUp || direction == RayDirection::kDown);
+	const bool forward = (direction == RayDirection::kDown || direction == RayDirection::kRight); // 添字が増える向きか
+
+	// 進行方向に直交する範囲（上下なら列、左右なら行）
+	int64_t acrossBegin = vertical ? columnOf(box.left) : rowOf(box.top);
+	int64_t acrossEnd = vertical ? columnOf(box.right) : rowOf(box.bottom);
+	acrossBegin = (std::max)(acrossBegin, int64_t{0});
+	acrossEnd = (std::min)(acrossEnd, (vertical ? numHorizontal : numVertical) - 1);
+	if (acrossBegin > acrossEnd) {
+		return std::nullopt;
+	}
+
+	// 進行方向側の辺があるセル。進む先でマップを抜けていれば当たらない、手前側の外なら端から調べる
+	int64_t along = 0;
+	switch (direction) {
+	case RayDirection::kLeft:
+		along = columnOf(box.left);
+		break;
+	case RayDirection::kRight:
+		along = columnOf(box.right);
+		break;
+	case RayDirection::kUp:
+		along = rowOf(box.top);
+		break;
+	default:
+		along = rowOf(box.bottom);
+		break;
+	}
+	const int64_t alongSize = vertical ? numVertical : numHorizontal;
+	if (forward ? along >= alongSize : along < 0) {
+		return std::nullopt;
+	}
+	along = std::clamp(along, int64_t{0}, alongSize - 1);
+
+	// 列（行）ごとに、進行方向にある最初のブロックをビットグリッドのワード単位で探し、一番近い面までの距離を取る
+	std::optional<float> nearest;
+	for (int64_t across = acrossBegin; across <= acrossEnd; ++across) {
+		const uint32_t xIndex = static_cast<uint32_t>(vertical ? across : along);
+		const uint32_t yIndex = static_cast<uint32_t>(vertical ? along : across);
+		const std::optional<uint32_t> hit = FindFirstSolid(xIndex, yIndex, direction);
+		if (!hit) {
+			continue;
+		}
+
+		const Rect rect = vertical ? GetRectByIndex(xIndex, *hit) : GetRectByIndex(*hit, yIndex);
+
+		float distance = 0.0f;
+		switch (direction) {
+		case RayDirection::kLeft:
+			distance = box.left - rect.right;
+			break;
+		case RayDirection::kRight:
+			distance = rect.left - box.right;
+			break;
+		case RayDirection::kUp:
+			distance = rect.bottom - box.top;
+			break;
+		default:
+			distance = box.bottom - rect.top;
+			break;
+		}
+		// 既にめり込んでいるなら 0
+		distance = (std::max)(distance, 0.0f);
+		if (!nearest || distance < *nearest) {
+			nearest = distance;
+		}
+	}
+
+	if (!nearest || *nearest > maxDistance) {
+		return std::nullopt;
+	}
+	return nearest;
+}
+
+std::optional<float> MapChipField::Raycast(const Vector3& origin, RayDirection direction, float maxDistance) const {
+	return Sweep(Rect{origin.x, origin.x, origin.y, origin.y}, direction, maxDistance);
+}
+
+std::optional<MapChipField::SweepHit> MapChipField::SweepAABB(const AABB& box, const Vector3& move) const {
+
+	if (mapChipData_.numBlockVirtical == 0 || mapChipData_.numBlockHorizontal == 0 || (move.x == 0.0f && move.y == 0.0f)) {
+		return std::nullopt;
+	}
+
+	// ワールド座標 → 符号付きの列・行（ワールドの下から数えた行）
+	auto columnAt = [](float x) { return std::floor((x + kBlockWidth / 2) / kBlockWidth); };
+	auto rowAt = [](float y) { return std::floor((y + kBlockHeight / 2) / kBlockHeight); };
+	auto toYIndex = [&](float row) { return static_cast<uint32_t>(static_cast<int64_t>(mapChipData_.numBlockVirtical) - 1 - static_cast<int64_t>(row)); };
+	auto toXIndex = [](float column) { return static_cast<uint32_t>(static_cast<int64_t>(column)); };
+
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	// 進行方向の辺がいまいる列と、次の境界を越える時刻・1列進むのにかかる時刻
+	const float stepX = (move.x > 0.0f) ? 1.0f : -1.0f;
+	const float leadX = (move.x > 0.0f) ? box.max.x : box.min.x;
+	// 境界ちょうどの辺は、進行方向の手前側の列にいるとみなす
+	float columnX = (move.x > 0.0f) ? std::ceil((leadX + kBlockWidth / 2) / kBlockWidth) - 1.0f : columnAt(leadX);
+	float tMaxX = infinity;
+	float tDeltaX = infinity;
+	if (move.x != 0.0f) {
+		const float boundaryX = (columnX + (move.x > 0.0f ? 1.0f : 0.0f)) * kBlockWidth - kBlockWidth / 2;
+		tMaxX = (boundaryX - leadX) / move.x;
+		tDeltaX = kBlockWidth / std::fabs(move.x);
+	}
+
+	const float stepY = (move.y > 0.0f) ? 1.0f : -1.0f;
+	const float leadY = (move.y > 0.0f) ? box.max.y : box.min.y;
+	float rowY = (move.y > 0.0f) ? std::ceil((leadY + kBlockHeight / 2) / kBlockHeight) - 1.0f : rowAt(leadY);
+	float tMaxY = infinity;
+	float tDeltaY = infinity;
+	if (move.y != 0.0f) {
+		const float boundaryY = (rowY + (move.y > 0.0f ? 1.0f : 0.0f)) * kBlockHeight - kBlockHeight / 2;
+		tMaxY = (boundaryY - leadY) / move.y;
+		tDeltaY = kBlockHeight / std::fabs(move.y);
+	}
+
+	// 境界を越えるたびに、新しく入った列（行）のうち箱が重なる範囲だけをビットグリッドで調べる
+	while (tMaxX <= 1.0f || tMaxY <= 1.0f) {
+		if (tMaxX <= tMaxY) {
+			const float t = tMaxX;
+			columnX += stepX;
+			const float top = rowAt(box.max.y + move.y * t - kSweepEpsilon);
+			const float bottom = rowAt(box.min.y + move.y * t + kSweepEpsilon);
+			const uint32_t xIndex = toXIndex(columnX);
+			uint32_t yBegin = toYIndex(top);
+			uint32_t yEnd = toYIndex(bottom);
+			if (columnX >= 0.0f && ClampSpan(yBegin, yEnd, mapChipData_.numBlockVirtical) && AnySolidInColumn(xIndex, yBegin, yEnd)) {
+				// 当たったブロックは範囲の上から最初のもの
+				while (!IsSolid(xIndex, yBegin)) {
+					++yBegin;
+				}
+				return SweepHit{t, Vector3(-stepX, 0.0f, 0.0f), IndexSet{xIndex, yBegin}};
+			}
+			tMaxX += tDeltaX;
+		} else {
+			const float t = tMaxY;
+			rowY += stepY;
+			const float left = columnAt(box.min.x + move.x * t + kSweepEpsilon);
+			const float right = columnAt(box.max.x + move.x * t - kSweepEpsilon);
+			const uint32_t yIndex = toYIndex(rowY);
+			uint32_t xBegin = toXIndex(left);
+			uint32_t xEnd = toXIndex(right);
+			if (rowY >= 0.0f && ClampSpan(xBegin, xEnd, mapChipData_.numBlockHorizontal) && AnySolidInRow(yIndex, xBegin, xEnd)) {
+				// 当たったブロックは範囲の左から最初のもの
+				while (!IsSolid(xBegin, yIndex)) {
+					++xBegin;
+				}
+				return SweepHit{t, Vector3(0.0f, -stepY, 0.0f), IndexSet{xBegin, yIndex}};
+			}
+			tMaxY += tDeltaY;
+		}
+	}
+
+	return std::nullopt;
+}
+
+// ============================
+// チャンク読み込み
+// ============================
+
+void MapChipField::UpdateStreaming(float focusX) {
+
+	uint32_t first = 0;
+	uint32_t last = 0;
+	if (!streamThread_.joinable() || !GetDesiredChunkRange(focusX, first, last)) {
+		return;
+	}
+
+	EvictChunksOutside(first, last);
+
+	std::vector<PreparedChunk> results;
+	{
+		std::lock_guard<std::mutex> lock(streamMutex_);
+		results.swap(streamResults_);
+
+		// まだ手を付けていない要求のうち、範囲外になったものは取り消す
+		std::erase_if(streamRequests_, [&](uint32_t chunkIndex) {
+			if (chunkIndex >= first && chunkIndex <= last) {
+				return false;
+			}
+			std::erase(pendingChunks_, chunkIndex);
+			return true;
+		});
+	}
+
+	// 読み込み済みのチャンクを反映
+	for (PreparedChunk& prepared : results) {
+		std::erase(pendingChunks_, prepared.chunkIndex);
+		if (prepared.chunkIndex >= first && prepared.chunkIndex <= last && !IsChunkResident(prepared.chunkIndex)) {
+			CommitChunk(std::move(prepared));
+		}
+	}
+
+	// 足りないチャンクを要求
+	bool requested = false;
+	{
+		std::lock_guard<std::mutex> lock(streamMutex_);
+		for (uint32_t chunkIndex = first; chunkIndex <= last; ++chunkIndex) {
+			if (IsChunkResident(chunkIndex) || std::find(pendingChunks_.begin(), pendingChunks_.end(), chunkIndex) != pendingChunks_.end()) {
+				continue;
+			}
+			pendingChunks_.push_back(chunkIndex);
+			streamRequests_.push_back(chunkIndex);
+			requested = true;
+		}
+	}
+	if (requested) {
+		streamCondition_.notify_one();
+	}
+}
+
+void MapChipField::PrimeStreaming(float focusX) {
+
+	uint32_t first = 0;
+	uint32_t last = 0;
+	if (!GetDesiredChunkRange(focusX, first, last)) {
+		return;
+	}
+
+	// 再スポーンなどで離れた位置から呼ばれても上限を超えないよう、先に範囲外を捨てる
+	EvictChunksOutside(first, last);
+
+	for (uint32_t chunkIndex = first; chunkIndex <= last; ++chunkIndex) {
+		if (!IsChunkResident(chunkIndex)) {
+			CommitChunk(PrepareChunk(chunkIndex));
+		}
+	}
+}
+
+void MapChipField::EvictChunksOutside(uint32_t first, uint32_t last) {
+	// 範囲から外れたチャンクを捨てる
+	for (size_t i = 0; i < residentChunks_.size();) {
+		BlockChunk& chunk = residentChunks_[i];
+		if (chunk.chunkIndex >= first && chunk.chunkIndex <= last) {
+			++i;
+			continue;
+		}
+		chunk = std::move(residentChunks_.back());
+		residentChunks_.pop_back();
+	}
+}
+
+MapChipField::MemoryUsage MapChipField::GetMemoryUsage() const {
+
+	MemoryUsage usage;
+	usage.tileBytes = mapChipData_.data.size_bytes();
+	usage.solidBitBytes = (solidRowBits_.size() + solidColumnBits_.size()) * sizeof(uint64_t);
+
+	for (const BlockChunk& chunk : residentChunks_) {
+		usage.blockChunkBytes += chunk.instances.GetByteSize();
+	}
+	return usage;
+}
+
+bool MapChipField::GetDesiredChunkRange(float focusX, uint32_t& first, uint32_t& last) const {
+
+	const uint32_t numChunks = GetNumChunks();
+	if (numChunks == 0) {
+		return false;
+	}
+
+	// ブロック中心が整数座標なので半ブロックずらしてからチャンク番号へ
+	const float chunkWorldWidth = kBlockWidth * kChunkWidth;
+	const float focusChunk = std::floor((focusX + kBlockWidth / 2.0f) / chunkWorldWidth);
+	const int64_t center = std::clamp(static_cast<int64_t>(focusChunk), int64_t{0}, static_cast<int64_t>(numChunks) - 1);
+
+	first = static_cast<uint32_t>((std::max)(center - int64_t{kStreamBehindChunks}, int64_t{0}));
+	last = static_cast<uint32_t>((std::min)(center + int64_t{kStreamAheadChunks}, static_cast<int64_t>(numChunks) - 1));
+	return true;
+}
+
+bool MapChipField::IsChunkResident(uint32_t chunkIndex) const {
+	return std::any_of(residentChunks_.begin(), residentChunks_.end(), [&](const BlockChunk& chunk) { return chunk.chunkIndex == chunkIndex; });
+}
+
+MapChipField::PreparedChunk MapChipField::PrepareChunk(uint32_t chunkIndex) const {
+
+	PreparedChunk prepared;
+	prepared.chunkIndex = chunkIndex;
+
+	// チャンクの列だけをビットグリッドから拾う（ステージ全体の位置の配列は持たない）
+	prepared.instances.Build(*this, chunkIndex);
+	return prepared;
+}
+
+void MapChipField::CommitChunk(PreparedChunk&& prepared) {
+
+	assert(residentChunks_.size() < kMaxResidentChunks);
+
+	// ブロックは動かないので、位置の配列をそのまま持つだけ（描画時に BlockRenderer が見えている分を送る）
+	BlockChunk chunk;
+	chunk.chunkIndex = prepared.chunkIndex;
+	chunk.instances = std::move(prepared.instances);
+	residentChunks_.push_back(std::move(chunk));
+}
+
+void MapChipField::ReleaseAllChunks() {
+	residentChunks_.clear();
+	pendingChunks_.clear();
+}
+
+void MapChipField::StartStreamThread() {
+	streamStop_ = false;
+	streamThread_ = std::thread(&MapChipField::StreamThreadMain, this);
+}
+
+void MapChipField::StopStreamThread() {
+	if (!streamThread_.joinable()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(streamMutex_);
+		streamStop_ = true;
+	}
+	streamCondition_.notify_all();
+	streamThread_.join();
+
+	streamRequests_.clear();
+	streamResults_.clear();
+	pendingChunks_.clear();
+}
+
+void MapChipField::StreamThreadMain() {
+	for (;;) {
+		uint32_t chunkIndex = 0;
+		{
+			std::unique_lock<std::mutex> lock(streamMutex_);
+			streamCondition_.wait(lock, [&] { return streamStop_ || !streamRequests_.empty(); });
+			if (streamStop_) {
+				return;
+			}
+			chunkIndex = streamRequests_.front();
+			streamRequests_.pop_front();
+		}
+
+		PreparedChunk prepared = PrepareChunk(chunkIndex);
+
+		std::lock_guard<std::mutex> lock(streamMutex_);
+		streamResults_.push_back(std::move(prepared));
+	}
+}
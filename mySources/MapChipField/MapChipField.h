@@ -1,19 +1,34 @@
 #pragma once
+#include "BlockRenderer/BlockInstanceBuffer.h"
+#include "StageBinary/StageBinary.h"
+#include "struct.h"
 #include <KamataEngine.h>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace KamataEngine;
 
-enum class MapChipType {
+enum class MapChipType : uint8_t {
 	kAir,   // 空白
 	kBlock, // ブロック
 };
 
 struct MapChipData {
-	std::vector<std::vector<MapChipType>> data;
+	// CSVから読み取ったマップの大きさ
+	uint32_t numBlockVirtical = 0;
+	uint32_t numBlockHorizontal = 0;
+	// 行優先で1本に詰めたタイル配列（index = yIndex * numBlockHorizontal + xIndex）
+	// CSVなら storage を、ステージバイナリならマップしたファイルをそのまま指す
+	std::span<const MapChipType> data;
+	std::vector<MapChipType> storage;
 };
 
 class MapChipField {
@@ -31,24 +46,159 @@ public:
 		float top;
 	};
 
+	// QuerySolids の結果。範囲は一度だけ求め、範囲内のブロックはビットグリッドから順に取り出す
+	class SolidQuery {
+	public:
+		// 範囲内のブロックを行優先（左上から）で1つずつ返す
+		class Iterator {
+		public:
+			IndexSet operator*() const { return current_; }
+			Iterator& operator++();
+			bool operator==(std::default_sentinel_t) const { return done_; }
+
+		private:
+			friend class SolidQuery;
+			const SolidQuery* query_ = nullptr;
+			IndexSet current_ = {};
+			bool done_ = true;
+
+			// (xIndex, yIndex) 以降で最初のブロックへ進む
+			void Seek(uint32_t xIndex, uint32_t yIndex);
+		};
+
+		// AABB の左上・右下の角があるセル（GetMapChipIndexSetByPosition と同じ値。辺の判定に使う）
+		IndexSet min = {};
+		IndexSet max = {};
+
+		Iterator begin() const;
+		std::default_sentinel_t end() const { return {}; }
+		bool Empty() const { return begin() == end(); }
+
+	private:
+		friend class MapChipField;
+		const MapChipField* field_ = nullptr;
+		// マップ内に収めた走査範囲（両端を含む）
+		uint32_t xBegin_ = 0;
+		uint32_t xEnd_ = 0;
+		uint32_t yBegin_ = 0;
+		uint32_t yEnd_ = 0;
+		bool valid_ = false;
+	};
+
+	// レイ・スイープの向き（kUp はワールドの上 = yIndex が小さくなる方向）
+	enum class RayDirection : uint8_t {
+		kLeft,
+		kRight,
+		kUp,
+		kDown,
+		kNum,
+	};
+
+	// SweepAABB の結果
+	struct SweepHit {
+		float time = 1.0f;   // 移動量のどの割合（0～1）で接触したか
+		Vector3 normal = {}; // 接触したブロックの面の法線（x か y のどちらかが ±1）
+		IndexSet index = {}; // 接触したブロック
+	};
+
+	// 列方向に kChunkWidth 列ずつ区切った、表示ブロックのまとまり
+	struct BlockChunk {
+		uint32_t chunkIndex = 0;
+		BlockInstanceBuffer instances; // 読み込みスレッドで作ったブロックの位置（BlockRenderer がそのまま GPU へ送る）
+	};
+
+	~MapChipField();
+
 	MapChipData mapChipData_;
 
 	void ResetMapChipData();
 
-	void LoadMapChipCSV(const std::string& filePath);
+	// CSVを読み込む。不正なセルがあれば行・列つきのエラーを残して false
+	bool LoadMapChipCSV(const std::string& filePath);
+	// メモリ上のCSVテキストを読み込む（sourceName はエラー表示用）
+	bool LoadMapChipCSVText(const char* text, size_t size, const std::string& sourceName);
+
+	// 変換済みのステージバイナリをマップして読み込む（解析なし）。失敗したら false
+	bool LoadMapChipBinary(const std::string& filePath);
+
+	// ステージ読み込みの入口。CSVの隣の .stage を使い、無い・古い・壊れている場合はCSVを読んで作り直す
+	bool LoadStage(const std::string& csvPath);
+
+	// 直前の読み込みの情報
+	const std::string& GetLoadError() const { return loadError_; }
+	size_t GetLoadedBytes() const { return loadedBytes_; }
+	bool IsLoadedFromBinary() const { return stageBinary_.IsOpen(); }
+
+	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const;
 
-	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex);
+	Vector3 GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) const;
 
-	Vector3 GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex);
+	// =============================
+	// チャンク読み込み
+	// 上限付きで持つのは表示用のデータ（ブロックのインスタンス）だけ
+	// 当たり判定・スポーン用のデータは、チャンクの境目をまたいでもそのまま引けるようステージ全体をずっと持つ（ステージの長さに比例する）
+	//   タイル 1 バイト/タイル、ビットグリッドは行・列それぞれ 1 ビット/タイル（64 タイル単位に切り上げ）、スポーン一覧
+	// =============================
 
-	// ブロックのワールドトランスフォーム配列
-	std::vector<std::vector<WorldTransform*>> worldTransformBlocks_;
-	// 表示ブロックの生成
+	// 表示ブロックの生成（チャンク読み込みスレッドを開始する）
 	void GenerateBlocks();
+	// focusX（カメラのX座標）に近づいたチャンクを裏で読み込み、後ろに離れたチャンクを捨てる
+	void UpdateStreaming(float focusX);
+	// 読み込みを待たずに focusX 周りのチャンクをその場で用意する（シーン開始時用）
+	void PrimeStreaming(float focusX);
+	// いま読み込まれているチャンク（順不同）
+	const std::vector<BlockChunk>& GetResidentBlockChunks() const { return residentChunks_; }
+	uint32_t GetNumChunks() const { return (mapChipData_.numBlockHorizontal + kChunkWidth - 1) / kChunkWidth; }
+	static uint32_t GetChunkWidth() { return kChunkWidth; }
+
+	// いま持っているデータの大きさ（デバッグ表示用）
+	struct MemoryUsage {
+		// ステージ全体（長さに比例）
+		size_t tileBytes = 0;     // タイル（バイナリならマップしたファイルの範囲）
+		size_t solidBitBytes = 0; // 行・列のビットグリッド
+		// 読み込んでいるチャンクだけ（上限付き）
+		size_t blockChunkBytes = 0; // インスタンス
+	};
+	MemoryUsage GetMemoryUsage() const;
+
+	IndexSet GetMapChipIndexSetByPosition(const Vector3& position) const;
+
+	Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const;
+
+	// =============================
+	// 1bit/タイルの「ブロックか？」グリッドへの問い合わせ
+	// 範囲はすべて両端を含む。負の座標から折り返した添字はマップ端に丸め、範囲外は空扱い
+	// =============================
 
-	IndexSet GetMapChipIndexSetByPosition(const Vector3& position);
+	bool IsSolid(uint32_t xIndex, uint32_t yIndex) const;
+	// yIndex 行の [xBegin, xEnd] 列にブロックがあるか
+	bool AnySolidInRow(uint32_t yIndex, uint32_t xBegin, uint32_t xEnd) const;
+	// xIndex 列の [yBegin, yEnd] 行にブロックがあるか
+	bool AnySolidInColumn(uint32_t xIndex, uint32_t yBegin, uint32_t yEnd) const;
+	// yIndex 行の [xBegin, xEnd] 列にあるブロックの数
+	uint32_t CountSolidInRow(uint32_t yIndex, uint32_t xBegin, uint32_t xEnd) const;
+	// (xIndex, yIndex) から direction に進んで（自身を含む）最初のブロックの行（上下）または列（左右）。無ければ nullopt
+	std::optional<uint32_t> FindFirstSolid(uint32_t xIndex, uint32_t yIndex, RayDirection direction) const;
 
-	Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex);
+	// 隣（行なら y+dy、列なら x+dx）が空いている“面”を持つブロックが範囲内にあるか（当たり判定用）
+	bool AnySolidFaceInRow(uint32_t yIndex, uint32_t xBegin, uint32_t xEnd, int32_t dy) const;
+	bool AnySolidFaceInColumn(uint32_t xIndex, uint32_t yBegin, uint32_t yEnd, int32_t dx) const;
+
+	// box を move だけ動かしたとき、最初に接触するブロックを求める（連続判定）
+	// 格子を DDA でたどり、先頭の辺が新しく入る行・列だけを調べる。開始時点で重なっているブロックは無視する
+	std::optional<SweepHit> SweepAABB(const AABB& box, const Vector3& move) const;
+
+	// aabb（XYのみ）に重なるセルの範囲を求める。辺の判定と範囲内ブロックの列挙に使う
+	SolidQuery QuerySolids(const AABB& aabb) const;
+
+	// =============================
+	// レイキャスト（FindFirstSolid で行・列ごとに最初のブロックを探す）
+	// =============================
+
+	// box の進行方向側の辺を direction に動かしたとき、ブロックの面に当たるまでの距離。maxDistance 以内に無ければ nullopt
+	std::optional<float> Sweep(const Rect& box, RayDirection direction, float maxDistance) const;
+	// origin から direction に伸ばした線がブロックの面に当たるまでの距離。maxDistance 以内に無ければ nullopt
+	std::optional<float> Raycast(const Vector3& origin, RayDirection direction, float maxDistance) const;
 
 	// スポーン情報の取得
 	const std::optional<IndexSet>& GetPlayerSpawnIndex() const { return playerSpawnIndex_; }
@@ -59,15 +209,82 @@ public:
 
 	static float GetBlockWidth() { return kBlockWidth; }
 	static float GetBlockHeight() { return kBlockHeight; }
-	static uint32_t GetNumBlockVirtical() { return kNumBlockVirtical; }
-	static uint32_t GetNumBlockHorizontal() { return kNumBlockHorizontal; }
+	// マップの大きさはCSVから決まる
+	uint32_t GetNumBlockVirtical() const { return mapChipData_.numBlockVirtical; }
+	uint32_t GetNumBlockHorizontal() const { return mapChipData_.numBlockHorizontal; }
 
 private:
 	static inline const float kBlockWidth = 2.0f;
 	static inline const float kBlockHeight = 2.0f;
 
-	static inline const uint32_t kNumBlockVirtical = 20;
-	static inline const uint32_t kNumBlockHorizontal = 100;
+	// チャンク1つの列数と、カメラの後ろ／前に保持するチャンク数
+	static inline const uint32_t kChunkWidth = 32;
+	static inline const uint32_t kStreamBehindChunks = 1;
+	static inline const uint32_t kStreamAheadChunks = 2;
+	// 同時に読み込むチャンクの上限（ステージの長さによらずこれ以上は持たない）
+	static inline const uint32_t kMaxResidentChunks = kStreamBehindChunks + 1 + kStreamAheadChunks;
+
+	// 読み込み結果
+	std::string loadError_;
+	size_t loadedBytes_ = 0;
+
+	// text を1つのバッファとして走査し、セルごとの文字列を作らずに解析する（ビットグリッドなどは作らない）
+	bool ParseMapChipCSV(const char* text, size_t size, const std::string& sourceName);
+	bool ReportLoadError(const std::string& message);
+
+	// バイナリから読み込んだ場合のマップ中のファイル（mapChipData_.data が指す先）
+	StageBinary stageBinary_;
+
+	// ブロック判定用のビットグリッド（行ごと・列ごとに 64bit ワードで保持）
+	uint32_t solidWordsPerRow_ = 0;
+	uint32_t solidWordsPerColumn_ = 0;
+	std::vector<uint64_t> solidRowBits_;    // [yIndex * solidWordsPerRow_ + xIndex / 64]
+	std::vector<uint64_t> solidColumnBits_; // [xIndex * solidWordsPerColumn_ + yIndex / 64]
+
+	// mapChipData_ からビットグリッドを作り直す
+	void BuildSolidBits();
+
+	uint64_t SolidRowWord(uint32_t yIndex, uint32_t word) const;
+	uint64_t SolidColumnWord(uint32_t xIndex, uint32_t word) const;
+
+	// SweepAABB で、辺がちょうど境界に乗っている行・列を含めないための幅
+	static inline const float kSweepEpsilon = 1.0e-4f;
+
+
+	// =============================
+	// チャンク読み込み
+	// =============================
+
+	// 読み込みスレッドが用意する、チャンク内ブロックの位置一覧
+	struct PreparedChunk {
+		uint32_t chunkIndex = 0;
+		BlockInstanceBuffer instances;
+	};
+
+	// メインスレッドのみが触る
+	std::vector<BlockChunk> residentChunks_;
+	std::vector<uint32_t> pendingChunks_; // 要求済みで未反映のチャンク
+
+	// 読み込みスレッドと共有（streamMutex_ で保護）
+	std::thread streamThread_;
+	std::mutex streamMutex_;
+	std::condition_variable streamCondition_;
+	std::deque<uint32_t> streamRequests_;
+	std::vector<PreparedChunk> streamResults_;
+	bool streamStop_ = false;
+
+	void StartStreamThread();
+	void StopStreamThread();
+	void StreamThreadMain();
+
+	// 読み込み後は書き換えないビットグリッドだけを読むので、どのスレッドからでも呼べる
+	PreparedChunk PrepareChunk(uint32_t chunkIndex) const;
+	void CommitChunk(PreparedChunk&& prepared);
+	void ReleaseAllChunks();
+	// [first, last] の外にあるチャンクを捨てる
+	void EvictChunksOutside(uint32_t first, uint32_t last);
+	bool IsChunkResident(uint32_t chunkIndex) const;
+	bool GetDesiredChunkRange(float focusX, uint32_t& first, uint32_t& last) const;
 
 	// スポーン情報
 	std::optional<IndexSet> playerSpawnIndex_;
@@ -75,3 +292,18 @@ private:
 	std::vector<IndexSet> coinSpawnIndices_;
 	std::vector<IndexSet> goalSpawnIndices_;
 };
+
+#ifdef _DEBUG
+// 旧ローダー（stringstream・std::map）と LoadMapChipCSVText の速さを、メモリ上に作ったCSVで比べる（デバッグ表示用）
+// 新しいほうはビットグリッドなど当たり判定用データの構築まで含めて測る
+struct CsvLoadBenchmark {
+	uint32_t numRows = 0;
+	uint32_t numColumns = 0;
+	size_t byteSize = 0;
+	double referenceMegaBytesPerSecond = 0.0; // 旧ローダー
+	double scannerMegaBytesPerSecond = 0.0;
+	bool resultsMatch = false; // 両方のタイルとスポーンが一致したか
+};
+
+CsvLoadBenchmark RunCsvLoadBenchmark(uint32_t numRows, uint32_t numColumns);
+#endif // _DEBUG
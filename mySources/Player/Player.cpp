@@ -1,6 +1,5 @@
 #define NOMIMAX
 #include "Player.h"
-#include "MapChipField/MapChipField.h"
 #include "cassert"
 #include <algorithm>
 
@@ -13,37 +12,79 @@ void Player::Initialize(Camera* camera, const Vector3& position) {
 	worldTransform_.Initialize();
 	worldTransform_.translation_ = position;
 	worldTransform_.rotation_.y = std::numbers::pi_v<float> / 2.0f; // 初期状態でZ軸を向くようにY軸を90度回転
+
+	previousTranslation_ = position;
+	interpolatedPosition_ = position;
+}
+
+Player::~Player() {
+	if (kinematicBodies_) {
+		kinematicBodies_->Destroy(bodyId_);
+	}
+}
+
+void Player::SetKinematicBodySystem(KinematicBodySystem* kinematicBodies) {
+	kinematicBodies_ = kinematicBodies;
+	bodyId_ = kinematicBodies_->Create(kWidth, kHeight, kBlank);
+}
+
+void Player::HandleInput() {
+	// 1フレームに固定ステップが0回でも2回以上でも、押したジャンプは次のステップで1回だけ処理する
+	if (Input::GetInstance()->TriggerKey(DIK_SPACE) || Input::GetInstance()->TriggerKey(DIK_UP)) {
+		jumpRequested_ = true;
+	}
 }
 
 void Player::Update() {
 
+	// 描画の補間用にステップ開始時の位置を残す
+	previousTranslation_ = worldTransform_.translation_;
+
 	// =======================
 	// 移動処理
 	// =======================
 
-	collisionMapInfo_ = {}; // 衝突判定情報を初期化
-
-	collisionMapInfo_.move = velocity_ * deltaTime_; // 移動量を設定
+	const Vector3 move = velocity_ * deltaTime_; // 移動量を設定
 
 	Move(); // 移動処理
 
-	CollisionMapCheck(collisionMapInfo_); // 移動量を加味して衝突判定を行う
+	// 移動量を加味した衝突判定は、全キャラクターまとめて KinematicBodySystem で行う
+	kinematicBodies_->Submit(bodyId_, worldTransform_.translation_, move);
+}
+
+void Player::UpdateAfterMapCollision() {
 
-	MoveByCollisionCheck(collisionMapInfo_); // 衝突判定後の移動量を適用
+	const KinematicBody& body = kinematicBodies_->Get(bodyId_);
 
-	OnCellingCollision(collisionMapInfo_); // 天井と接触している場合
+	worldTransform_.translation_ = body.position; // 衝突判定後の移動量を適用
+
+	OnCellingCollision(body); // 天井と接触している場合
 
 	//OnFloorCollision(collisionMapInfo); // 床と接触している場合
 
-	OnWallCollision(collisionMapInfo_); // 壁と接触している場合
+	OnWallCollision(body); // 壁と接触している場合
 
-	Jump(collisionMapInfo_); // ジャンプ処理
+	Jump(body); // ジャンプ処理
 
-	SwitchOnGround(collisionMapInfo_); // 接地状態の切り替え処理
+	SwitchOnGround(body); // 接地状態の切り替え処理
 
 	ModelRotate(); // 回転処理
 
-	UpdateAffineTransformMatrix(); // アフィン変換行列の更新
+	// 行列は描画の前に InterpolateTransform で1回だけ作る
+}
+
+// =======================
+// 描画用の補間
+// =======================
+
+void Player::InterpolateTransform(float alpha) {
+	interpolatedPosition_ = lerp(previousTranslation_, worldTransform_.translation_, alpha);
+
+	// 行列だけ表示位置で作り直す（シミュレーション上の位置はそのまま）
+	const Vector3 translation = worldTransform_.translation_;
+	worldTransform_.translation_ = interpolatedPosition_;
+	UpdateAffineTransformMatrix();
+	worldTransform_.translation_ = translation;
 }
 
 // =======================
@@ -84,20 +125,8 @@ AABB Player::GetAABB() {
 // =======================
 
 void Player::UpdateAffineTransformMatrix() {
-	// スケール行列
-	Matrix4x4 scaleMat = MakeScaleMatrix(worldTransform_.scale_);
-	// 回転行列
-	Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransform_.rotation_.z);
-	Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransform_.rotation_.y);
-	Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransform_.rotation_.x);
-	Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-	// 平行移動行列
-	Matrix4x4 transMat = MakeTranslateMatrix(worldTransform_.translation_);
-	// アフィン変換行列の計算
-	worldTransform_.matWorld_ = scaleMat * rotMat * transMat;
-
-	// 行列を転送
-	worldTransform_.TransferMatrix();
+	// 拡縮・回転・位置が前回から変わったときだけ作り直して転送する
+	transformCache_.Update(worldTransform_);
 }
 
 // =======================
@@ -155,12 +184,13 @@ void Player::Move() {
 	}
 }
 
-void Player::Jump(CollisionMapInfo& info) {
+void Player::Jump(const KinematicBody& body) {
 	// ジャンプ入力
-	if (Input::GetInstance()->TriggerKey(DIK_SPACE) || Input::GetInstance()->TriggerKey(DIK_UP)) {
+	if (jumpRequested_) {
+		jumpRequested_ = false;
 
 		// 壁に接触していて、かつ空中であれば壁ジャンプ
-		if (info.wallCollision && !onGround_) {
+		if (body.wallCollision && !onGround_) {
 			if (wallJump_) {
 				return; // 既に壁ジャンプしていたら何もしない
 			}
@@ -221,168 +251,14 @@ void Player::ModelRotate() {
 	}
 }
 
-// ============================
-// 衝突判定を行う
-// ============================
-
-void Player::CollisionMapCheck(CollisionMapInfo& info) {
-
-	// 事前に移動後の四隅を一括算出（元コードの繰り返しを削減）
-	std::array<Vector3, kNumCorner> positionsNew;
-	for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-		positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.move, static_cast<Corner>(i));
-	} // 元の各関数で毎回やっていた処理をここで一度だけ実施 :contentReference[oaicite:10]{index=10}
-
-	// 上下左右の順で4回呼ぶ
-	const HitDir order[] = {HitDir::kUp, HitDir::kDown, HitDir::kRight, HitDir::kLeft};
-	for (HitDir d : order) {
-		CollisionOneSide(info, d, positionsNew);
-	}
-}
-
-// ============================
-// 角の座標を計算
-// ============================
-
-Vector3 Player::CornerPosition(const Vector3& center, Corner corner) {
-
-	Vector3 offsetTable[kNumCorner] = {
-	    {+kWidth / 2.0f, -kHeight / 2.0f, 0.0f}, //  右下
-	    {-kWidth / 2.0f, -kHeight / 2.0f, 0.0f}, //  左下
-	    {+kWidth / 2.0f, +kHeight / 2.0f, 0.0f}, //  右上
-	    {-kWidth / 2.0f, +kHeight / 2.0f, 0.0f}  //  左上
-	};
-	return center + offsetTable[static_cast<uint32_t>(corner)];
-}
-
-// ============================
-// 衝突判定後の移動量を適用
-// ============================
-
-void Player::MoveByCollisionCheck(const CollisionMapInfo& info) {
-
-	worldTransform_.translation_ += info.move; // 衝突判定後の移動量を適用
-}
-
-// ============================
-// 衝突判定を行う（方向ごとに）
-// ============================
-
-void Player::CollisionOneSide(CollisionMapInfo& info, HitDir dir, const std::array<Vector3, kNumCorner>& positionsNew) {
-	// 方向別の早期 return 条件
-	if (dir == HitDir::kUp && info.move.y <= 0.0f)
-		return; // 上昇時のみ天井判定
-	if (dir == HitDir::kDown && info.move.y >= 0.0f)
-		return; // 下降時のみ床判定
-	if (dir == HitDir::kRight && info.move.x <= 0.0f)
-		return; // 右移動時のみ右壁判定
-	if (dir == HitDir::kLeft && info.move.x >= 0.0f)
-		return; // 左移動時のみ左壁判定
-
-	bool hit = false;
-	MapChipField::IndexSet indexSet;
-	MapChipType mapChipType, mapChipTypeNext;
-
-	// 方向ごとに「見る角」「隣セル方向」を切り替える
-	auto testTwoPoints = [&](Corner a, Corner b, int dx, int dy) {
-		// 1点目
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[static_cast<uint32_t>(a)]);
-		mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-		mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex + dx, indexSet.yIndex + dy);
-		if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock)
-			hit = true;
-
-		// 2点目
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[static_cast<uint32_t>(b)]);
-		mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-		mapChipTypeNext = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex + dx, indexSet.yIndex + dy);
-		if (mapChipType == MapChipType::kBlock && mapChipTypeNext != MapChipType::kBlock)
-			hit = true;
-	};
-
-	switch (dir) {
-	case HitDir::kUp:
-		// 左上/右上、隣セルは +y（天井）
-		testTwoPoints(kLeftTop, kRightTop, 0, +1);
-		if (!hit)
-			return;
-
-		// 「移動後の上端」基準セルを取得して、rect.bottom から詰める（元実装）
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + info.move + Vector3(0.0f, -kHeight / 2.0f + kBlank, 0.0f));
-		// 直前セルの yIndex と違うときだけ当て込む（揺れ防止の元ロジック）
-		{
-			MapChipField::IndexSet now = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + Vector3(0.0f, kHeight / 2.0f + kBlank, 0.0f));
-			if (now.yIndex != indexSet.yIndex) {
-				MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-				float moveY = (rect.bottom - worldTransform_.translation_.y) - (kHeight / 2.0f + kBlank);
-				info.move.y = (std::max)(0.0f, moveY); // 上方向は正に詰める
-				info.cellingCollision = true;
-			}
-		}
-		break;
-
-	case HitDir::kDown:
-		// 左下/右下、隣セルは -y（床）
-		testTwoPoints(kLeftBottom, kRightBottom, 0, -1);
-		if (!hit)
-			return;
-
-		// 左下のセルを起点に、直前セル yIndex 変化を見て rect.top から詰める（元実装）
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom]);
-		{
-			MapChipField::IndexSet now = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ - Vector3(0.0f, kHeight / 2.0f, 0.0f));
-			if (now.yIndex != indexSet.yIndex) {
-				MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-				float moveY = (rect.top - worldTransform_.translation_.y) + (kHeight / 2.0f + kBlank);
-				info.move.y = (std::min)(0.0f, moveY); // 下方向は負に詰める 
-				info.floorCollision = true;
-			}
-		}
-		break;
-
-	case HitDir::kRight:
-		// 右下/右上、隣セルは x-1（ブロック左端と接触で詰め）
-		testTwoPoints(kRightBottom, kRightTop, -1, 0);
-		if (!hit)
-			return;
-
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + info.move + Vector3(kWidth / 2.0f + kBlank, 0.0f, 0.0f));
-		{
-			MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-			float moveX = (rect.left - worldTransform_.translation_.x) - (kWidth / 2.0f + kBlank);
-			info.move.x = (std::max)(0.0f, moveX); // 右方向は正に詰める
-			info.wallCollision = true;
-		}
-		break;
-
-	case HitDir::kLeft:
-		// 左下/左上、隣セルは x+1（ブロック右端と接触で詰め）
-		testTwoPoints(kLeftBottom, kLeftTop, +1, 0);
-		if (!hit)
-			return;
-
-		indexSet = mapChipField_->GetMapChipIndexSetByPosition(worldTransform_.translation_ + info.move - Vector3(kWidth / 2.0f + kBlank, 0.0f, 0.0f));
-		{
-			MapChipField::Rect rect = mapChipField_->GetRectByIndex(indexSet.xIndex, indexSet.yIndex);
-			float moveX = (rect.right - worldTransform_.translation_.x) + (kWidth / 2.0f + kBlank);
-			info.move.x = (std::min)(0.0f, moveX); // 左方向は負に詰める 
-			info.wallCollision = true;
-		}
-		break;
-
-	default:
-		break;
-	}
-}
-
-void Player::OnCellingCollision(CollisionMapInfo& info) {
-	if (info.cellingCollision) {
+void Player::OnCellingCollision(const KinematicBody& body) {
+	if (body.cellingCollision) {
 		velocity_.y = 0.0f; // 天井に当たったら上昇速度をリセット
 	}
 }
 
-void Player::OnWallCollision(CollisionMapInfo& info) {
-	if (info.wallCollision) {
+void Player::OnWallCollision(const KinematicBody& body) {
+	if (body.wallCollision) {
 		// 接地状態ならX速度を減衰
 		velocity_.x *= (1.0f - kAttenuationWall);
 	}
@@ -392,7 +268,7 @@ void Player::OnWallCollision(CollisionMapInfo& info) {
 // 接地状態の切り替え処理
 // ============================
 
-void Player::SwitchOnGround(CollisionMapInfo& info) {
+void Player::SwitchOnGround(const KinematicBody& body) {
 
 	if (onGround_) {
 
@@ -402,29 +278,8 @@ void Player::SwitchOnGround(CollisionMapInfo& info) {
 		} else {
 
 			// 　落下判定
-			//  移動後の4つの角の座標を計算
-			std::array<Vector3, kNumCorner> positionsNew;
-			for (uint32_t i = 0; i < positionsNew.size(); ++i) {
-				positionsNew[i] = CornerPosition(worldTransform_.translation_ + info.move, static_cast<Corner>(i));
-			}
-
-			MapChipType mapChipType;
-			MapChipField::IndexSet indexSet;
-			bool hit = false;
-
-			// 左下点の判定
-			indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kLeftBottom] + Vector3(0, -kBlank, 0));
-			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-			if (mapChipType == MapChipType::kBlock) {
-				hit = true;
-			}
-
-			// 右下点の判定
-			indexSet = mapChipField_->GetMapChipIndexSetByPosition(positionsNew[kRightBottom] + Vector3(0, -kBlank, 0));
-			mapChipType = mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex);
-			if (mapChipType == MapChipType::kBlock) {
-				hit = true;
-			}
+			//  足元の床の有無は当たり判定と一緒に KinematicBodySystem が調べている
+			const bool hit = body.groundBelow;
 
 			// 落下開始
 			if (!hit) {
@@ -438,7 +293,7 @@ void Player::SwitchOnGround(CollisionMapInfo& info) {
 		// 空中状態の処理
 
 		// 着地フラグ
-		if (info.floorCollision) {
+		if (body.floorCollision) {
 			// 着地状態に切り替える(落下を止める)
 			onGround_ = true;
 			// 着地時にX速度を減衰
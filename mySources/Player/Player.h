@@ -1,4 +1,6 @@
 #pragma once
+#include "../KinematicBody/KinematicBody.h"
+#include "../TransformCache/TransformCache.h"
 #include "../struct.h"
 #include <KamataEngine.h>
 #include <cmath>
@@ -11,35 +13,13 @@ enum class LRDirection {
 	kLeft,
 };
 
-class MapChipField;
 class Enemy;
 
 class Player {
 private:
-	struct CollisionMapInfo {
-		// 天井衝突フラグ
-		bool cellingCollision = false;
-		// 床衝突フラグ
-		bool floorCollision = false;
-		// 壁衝突フラグ
-		bool wallCollision = false;
-		// 移動量
-		Vector3 move;
-	};
-
-	enum Corner {
-		kRightBottom, // 右下
-		kLeftBottom,  // 左下
-		kRightTop,    // 右上
-		kLeftTop,     // 左上
-		kNumCorner    // 要素数
-	};
-
-	// 方向を表す
-	enum HitDir { kUp, kDown, kRight, kLeft, kCount };
-
 	// ワールド変換データ
 	WorldTransform worldTransform_;
+	TransformCache transformCache_; // 動いたときだけ行列を作り直す
 	// モデル
 	Model* model_ = nullptr;
 	// カメラ
@@ -47,6 +27,10 @@ private:
 
 	Vector3 velocity_ = {};
 
+	// 描画の補間用（直前の固定ステップ開始時の位置と、補間した表示位置）
+	Vector3 previousTranslation_ = {};
+	Vector3 interpolatedPosition_ = {};
+
 	float deltaTime_; // デフォルトのデルタタイム
 
 	static inline const float kAcceleration = 32.0f;  // 加速度
@@ -65,14 +49,16 @@ private:
 	bool landing_ = false;  // 着地フラグ
 	bool doubleJump_ = false; // 二段ジャンプ可能フラグ
 	bool wallJump_ = false;   // 壁ジャンプ可能フラグ
+	bool jumpRequested_ = false; // 次の固定ステップで処理するジャンプ入力
 
 	static inline const float kGravityAcceleration = 30.0f; // 重力加速度
 	static inline const float kLimitFallSpeed = 20.0f;      // 最大落下速度
 	static inline const float kJumpAcceleration = 20.0f;    // ジャンプ加速度
 	static inline const float kJumpX = 40.0f;              // ジャンプ時の横移動力
 
-	// マップチップフィールド
-	MapChipField* mapChipField_ = nullptr;
+	// マップとの当たり判定を行うボディ
+	KinematicBodySystem* kinematicBodies_ = nullptr;
+	KinematicBodySystem::BodyId bodyId_ = 0;
 
 	// プレイヤーの当たり判定サイズ
 	static inline const float kWidth = 1.8f;  // プレイヤーの当たり判定サイズ
@@ -84,13 +70,23 @@ private:
 
 	bool isDead_ = false; // 死亡フラグ
 
-	CollisionMapInfo collisionMapInfo_;
-
 public:
+	~Player();
+
 	void Initialize(Camera* camera, const Vector3& position);
 
+	// 押した瞬間の入力を拾っておく（固定ステップの回数に関係なく毎フレーム1回呼ぶ）
+	void HandleInput();
+
+	// 入力と移動量の計算まで。マップとの当たり判定は KinematicBodySystem がまとめて行う
 	void Update();
 
+	// 当たり判定の結果を反映する（KinematicBodySystem::ResolveMapCollisions の後に呼ぶ）
+	void UpdateAfterMapCollision();
+
+	// 直前の固定ステップと現在の位置を alpha で補間して描画用の行列を作る
+	void InterpolateTransform(float alpha);
+
 	void Draw();
 
 	// =============================
@@ -113,12 +109,14 @@ public:
 
 	const WorldTransform& GetWorldTransform() const { return worldTransform_; }
 
+	// 補間済みの表示位置（カメラの追従用）
+	const Vector3& GetInterpolatedPosition() const { return interpolatedPosition_; }
+
 	const Vector3& GetVelocity() const { return velocity_; }
 	bool IsOnGround() const { return onGround_; }
 
-	void SetMapChipField(MapChipField* mapChipField) { mapChipField_ = mapChipField; }
-
-	Vector3 CornerPosition(const Vector3& center, Corner corner);
+	// ボディを登録する
+	void SetKinematicBodySystem(KinematicBodySystem* kinematicBodies);
 
 	bool GetIsDead() const { return isDead_; }
 
@@ -131,27 +129,18 @@ public:
 	// 移動入力
 	void Move();
 	// ジャンプ入力
-	void Jump(CollisionMapInfo& info);
+	void Jump(const KinematicBody& body);
 	// モデルの旋回処理
 	void ModelRotate();
 
-	// マップ衝突判定
-	void CollisionMapCheck(CollisionMapInfo& info);
-
-	// 判定結果を反映して移動させる
-	void MoveByCollisionCheck(const CollisionMapInfo& info);
-
-	// 1方向ぶんの当たり判定（positionsNew は事前計算した四隅）
-	void CollisionOneSide(CollisionMapInfo& info, HitDir dir, const std::array<Vector3, kNumCorner>& positionsNew);
-
 	// 天井に接触している場合の処理
-	void OnCellingCollision(CollisionMapInfo& info);
+	void OnCellingCollision(const KinematicBody& body);
 
 	// 壁に接触している場合の処理
-	void OnWallCollision(CollisionMapInfo& info);
+	void OnWallCollision(const KinematicBody& body);
 
 	// 接地状態の切り替え処理
-	void SwitchOnGround(CollisionMapInfo& info);
+	void SwitchOnGround(const KinematicBody& body);
 
 	void OnEnemyCollision(Enemy* enemy);
 };
@@ -0,0 +1,39 @@
+#include "SceneArena.h"
+#include <algorithm>
+
+void* SceneArena::Allocate(size_t size, size_t alignment) {
+
+	// 今のブロックに収まらなければ新しいブロックを足す（大きいものはそれ専用のブロックにする）
+	const auto fits = [&] {
+		if (!cursor_) {
+			return false;
+		}
+		const uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+		return aligned + size <= reinterpret_cast<uintptr_t>(end_);
+	};
+	if (!fits()) {
+		const size_t blockSize = (std::max)(blockSize_, size + alignment);
+		blocks_.push_back(std::make_unique_for_overwrite<std::byte[]>(blockSize));
+		cursor_ = blocks_.back().get();
+		end_ = cursor_ + blockSize;
+	}
+
+	std::byte* memory = cursor_ + ((alignment - reinterpret_cast<uintptr_t>(cursor_) % alignment) % alignment);
+	cursor_ = memory + size;
+	usedBytes_ += size;
+	return memory;
+}
+
+void SceneArena::Release() {
+
+	// 後から作ったものが先に作ったものを参照していることがあるので、逆順に壊す
+	for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+		it->destroy(it->object);
+	}
+	destructors_.clear();
+
+	blocks_.clear();
+	cursor_ = nullptr;
+	end_ = nullptr;
+	usedBytes_ = 0;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// シーンと同じ寿命のオブジェクトを置くアリーナ
+// 大きめのブロックから詰めて切り出すだけなので、1つずつ new するより速く、断片化もしない
+// Release（またはアリーナの破棄）で、作った逆順にデストラクタを呼んでからブロックをまとめて返す
+// シーンが持つものをすべてここから作れば、個別の delete 漏れが起きない
+class SceneArena {
+public:
+	explicit SceneArena(size_t blockSize = kDefaultBlockSize) : blockSize_(blockSize) {}
+	~SceneArena() { Release(); }
+
+	SceneArena(const SceneArena&) = delete;
+	SceneArena& operator=(const SceneArena&) = delete;
+
+	// アリーナの中にオブジェクトを作る（delete してはいけない）
+	template <typename T, typename... Args> T* Create(Args&&... args) {
+		T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			destructors_.push_back({object, [](void* p) { static_cast<T*>(p)->~T(); }});
+		}
+		return object;
+	}
+
+	// エンジンが new で作ったもの（Model::CreateFromOBJ など）を預かり、Release で delete する
+	template <typename T> T* Adopt(T* object) {
+		if (object) {
+			destructors_.push_back({object, [](void* p) { delete static_cast<T*>(p); }});
+		}
+		return object;
+	}
+
+	// 生のメモリを切り出す（デストラクタは呼ばれない）
+	void* Allocate(size_t size, size_t alignment);
+
+	// 作った逆順に破棄し、ブロックをすべて返す
+	void Release();
+
+	size_t GetUsedBytes() const { return usedBytes_; }
+	size_t GetBlockCount() const { return blocks_.size(); }
+	size_t GetObjectCount() const { return destructors_.size(); }
+
+private:
+	static inline const size_t kDefaultBlockSize = 64 * 1024;
+
+	struct Destructor {
+		void* object;
+		void (*destroy)(void* object);
+	};
+
+	size_t blockSize_;
+	std::vector<std::unique_ptr<std::byte[]>> blocks_;
+	std::byte* cursor_ = nullptr; // 今のブロックの空きの先頭
+	std::byte* end_ = nullptr;    // 今のブロックの終わり
+	size_t usedBytes_ = 0;
+
+	std::vector<Destructor> destructors_;
+};
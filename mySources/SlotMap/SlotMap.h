@@ -0,0 +1,182 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 容量を最初に決めて確保しておくオブジェクトの入れ物（スロットマップ）
+// ・オブジェクトは確保済みの領域にその場で作るので、プレイ中の生成・破棄でメモリを確保しない
+// ・生きているものは生成順に詰めた番号の配列でたどる（リストのポインタを1つずつ追わない）
+// ・ハンドルは世代番号つきなので、破棄後に同じスロットが再利用されても古いハンドルは無効になる
+// ・Despawn したものはすぐに巡回から外れるが、破棄は FlushDespawned まで遅らせる（同じフレーム中はポインタが有効）
+template <typename T> class SlotMap {
+public:
+	struct Handle {
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+
+		bool operator==(const Handle&) const = default;
+	};
+
+	SlotMap() = default;
+	~SlotMap() { Clear(); }
+
+	SlotMap(const SlotMap&) = delete;
+	SlotMap& operator=(const SlotMap&) = delete;
+
+	// 容量を決めて確保する（空のときだけ呼べる）
+	void Reserve(uint32_t capacity) {
+		assert(dense_.empty() && despawned_.empty());
+		storage_ = std::make_unique<Storage[]>(capacity);
+		generations_.assign(capacity, 0);
+		states_.assign(capacity, State::kFree);
+		dense_.reserve(capacity);
+		despawned_.reserve(capacity);
+		freeSlots_.clear();
+		freeSlots_.reserve(capacity);
+		// 若い番号から使うように積む
+		for (uint32_t i = capacity; i > 0; --i) {
+			freeSlots_.push_back(i - 1);
+		}
+		capacity_ = capacity;
+	}
+
+	// 空きスロットに作る。満杯なら作らずに無効なハンドル（Get で nullptr）を返す
+	template <typename... Args> Handle Spawn(Args&&... args) {
+		if (freeSlots_.empty()) {
+			return {};
+		}
+		const uint32_t index = freeSlots_.back();
+		freeSlots_.pop_back();
+
+		new (storage_[index].bytes) T(std::forward<Args>(args)...);
+		states_[index] = State::kAlive;
+		dense_.push_back(index);
+		return {index, generations_[index]};
+	}
+
+	// 巡回から外し、FlushDespawned で破棄する（無効なハンドルなら何もしない）
+	void Despawn(Handle handle) {
+		if (!IsAlive(handle)) {
+			return;
+		}
+		states_[handle.index] = State::kDespawned;
+		// 残りの並び順（生成順）は変えない
+		std::erase(dense_, handle.index);
+		despawned_.push_back(handle.index);
+	}
+	void Despawn(const T& object) { Despawn(HandleOf(object)); }
+
+	// pred が true を返したものをまとめて Despawn する（並び順は変えない）
+	template <typename Pred> void DespawnIf(Pred&& pred) {
+		std::erase_if(dense_, [&](uint32_t index) {
+			if (!pred(std::as_const(Object(index)))) {
+				return false;
+			}
+			states_[index] = State::kDespawned;
+			despawned_.push_back(index);
+			return true;
+		});
+	}
+
+	// Despawn したものを破棄してスロットを空ける（フレームの終わりに呼ぶ）
+	void FlushDespawned() {
+		for (uint32_t index : despawned_) {
+			Object(index).~T();
+			states_[index] = State::kFree;
+			++generations_[index];
+			freeSlots_.push_back(index);
+		}
+		despawned_.clear();
+	}
+
+	// すべて破棄する（容量はそのまま）
+	void Clear() {
+		while (!dense_.empty()) {
+			Despawn(Handle{dense_.back(), generations_[dense_.back()]});
+		}
+		FlushDespawned();
+	}
+
+	bool IsAlive(Handle handle) const { return handle.index < capacity_ && states_[handle.index] == State::kAlive && generations_[handle.index] == handle.generation; }
+
+	T* Get(Handle handle) { return IsAlive(handle) ? &Object(handle.index) : nullptr; }
+	const T* Get(Handle handle) const { return IsAlive(handle) ? &Object(handle.index) : nullptr; }
+
+	// この入れ物の中のオブジェクトのハンドル
+	Handle HandleOf(const T& object) const {
+		const uint32_t index = static_cast<uint32_t>(reinterpret_cast<const Storage*>(&object) - storage_.get());
+		assert(index < capacity_);
+		return {index, generations_[index]};
+	}
+
+	size_t size() const { return dense_.size(); }
+	bool empty() const { return dense_.empty(); }
+	uint32_t GetCapacity() const { return capacity_; }
+
+	// 生きているものを生成順にたどる
+	template <bool kConst> class IteratorBase {
+	public:
+		using Owner = std::conditional_t<kConst, const SlotMap, SlotMap>;
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<kConst, const T*, T*>;
+		using reference = std::conditional_t<kConst, const T&, T&>;
+
+		IteratorBase() = default;
+		IteratorBase(Owner* owner, const uint32_t* position) : owner_(owner), position_(position) {}
+
+		reference operator*() const { return owner_->Object(*position_); }
+		pointer operator->() const { return &owner_->Object(*position_); }
+		IteratorBase& operator++() {
+			++position_;
+			return *this;
+		}
+		IteratorBase operator++(int) {
+			IteratorBase result = *this;
+			++position_;
+			return result;
+		}
+		bool operator==(const IteratorBase& other) const { return position_ == other.position_; }
+
+	private:
+		Owner* owner_ = nullptr;
+		const uint32_t* position_ = nullptr;
+	};
+	using Iterator = IteratorBase<false>;
+	using ConstIterator = IteratorBase<true>;
+
+	Iterator begin() { return {this, dense_.data()}; }
+	Iterator end() { return {this, dense_.data() + dense_.size()}; }
+	ConstIterator begin() const { return {this, dense_.data()}; }
+	ConstIterator end() const { return {this, dense_.data() + dense_.size()}; }
+
+private:
+	enum class State : uint8_t {
+		kFree,      // 空き
+		kAlive,     // 生きている
+		kDespawned, // 巡回から外れ、破棄待ち
+	};
+
+	struct Storage {
+		alignas(T) std::byte bytes[sizeof(T)];
+	};
+
+	T& Object(uint32_t index) { return *std::launder(reinterpret_cast<T*>(storage_[index].bytes)); }
+	const T& Object(uint32_t index) const { return *std::launder(reinterpret_cast<const T*>(storage_[index].bytes)); }
+
+	uint32_t capacity_ = 0;
+	std::unique_ptr<Storage[]> storage_;
+	std::vector<uint32_t> generations_;
+	std::vector<State> states_;
+
+	std::vector<uint32_t> dense_;      // 生きているスロットの番号（生成順）
+	std::vector<uint32_t> freeSlots_;  // 空きスロットの番号
+	std::vector<uint32_t> despawned_;  // 破棄待ちのスロットの番号
+};
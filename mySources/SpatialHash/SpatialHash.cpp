@@ -0,0 +1,118 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+// ============================
+// 登録
+// ============================
+
+void SpatialHash::Clear() {
+	proxies_.clear();
+	bucketOffsets_.clear();
+	bucketItems_.clear();
+}
+
+SpatialHash::ProxyId SpatialHash::Insert(const AABB& aabb, uint32_t category, uint32_t mask, uint32_t userData) {
+	const ProxyId id = static_cast<ProxyId>(proxies_.size());
+	proxies_.push_back({aabb, category, mask, userData});
+	return id;
+}
+
+int32_t SpatialHash::CellCoord(float v) const { return static_cast<int32_t>(std::floor(v / cellSize_)); }
+
+uint32_t SpatialHash::BucketIndex(int32_t cellX, int32_t cellY) const {
+	// 大きな素数を掛けて混ぜる（負のセル座標もそのまま扱える）
+	const uint32_t h = static_cast<uint32_t>(cellX) * 73856093u ^ static_cast<uint32_t>(cellY) * 19349663u;
+	return h & bucketMask_;
+}
+
+// ============================
+// セルへの振り分け
+// ============================
+
+void SpatialHash::Build() {
+
+	// 1つの箱がまたぐセルの数を数え、バケット数はその2倍以上の2のべき乗にする
+	size_t cellCount = 0;
+	for (const Proxy& proxy : proxies_) {
+		const size_t w = static_cast<size_t>(CellCoord(proxy.aabb.max.x) - CellCoord(proxy.aabb.min.x) + 1);
+		const size_t h = static_cast<size_t>(CellCoord(proxy.aabb.max.y) - CellCoord(proxy.aabb.min.y) + 1);
+		cellCount += w * h;
+	}
+	const uint32_t bucketCount = (std::max)(kMinBucketCount, static_cast<uint32_t>(std::bit_ceil(cellCount * 2)));
+	bucketMask_ = bucketCount - 1;
+
+	// 各バケットの個数を数えて先頭位置を決め（CSR）、2回目で詰める
+	bucketOffsets_.assign(bucketCount + 1, 0);
+	for (const Proxy& proxy : proxies_) {
+		for (int32_t y = CellCoord(proxy.aabb.min.y); y <= CellCoord(proxy.aabb.max.y); ++y) {
+			for (int32_t x = CellCoord(proxy.aabb.min.x); x <= CellCoord(proxy.aabb.max.x); ++x) {
+				++bucketOffsets_[BucketIndex(x, y) + 1];
+			}
+		}
+	}
+	for (uint32_t b = 0; b < bucketCount; ++b) {
+		bucketOffsets_[b + 1] += bucketOffsets_[b];
+	}
+
+	bucketItems_.resize(cellCount);
+	bucketCursors_.assign(bucketOffsets_.begin(), bucketOffsets_.begin() + bucketCount);
+	for (ProxyId id = 0; id < proxies_.size(); ++id) {
+		const AABB& aabb = proxies_[id].aabb;
+		for (int32_t y = CellCoord(aabb.min.y); y <= CellCoord(aabb.max.y); ++y) {
+			for (int32_t x = CellCoord(aabb.min.x); x <= CellCoord(aabb.max.x); ++x) {
+				bucketItems_[bucketCursors_[BucketIndex(x, y)]++] = {id, x, y};
+			}
+		}
+	}
+}
+
+// ============================
+// 組の列挙
+// ============================
+
+void SpatialHash::FindPairs(std::vector<Pair>& pairs) const {
+
+	pairs.clear();
+
+	const uint32_t bucketCount = bucketMask_ + 1;
+	for (uint32_t b = 0; b < bucketCount && b + 1 < bucketOffsets_.size(); ++b) {
+		const uint32_t begin = bucketOffsets_[b];
+		const uint32_t end = bucketOffsets_[b + 1];
+
+		for (uint32_t i = begin; i < end; ++i) {
+			const CellItem& itemA = bucketItems_[i];
+			const Proxy& proxyA = proxies_[itemA.id];
+
+			for (uint32_t j = i + 1; j < end; ++j) {
+				const CellItem& itemB = bucketItems_[j];
+
+				// 同じバケットでも別のセルなら関係ない
+				if (itemA.cellX != itemB.cellX || itemA.cellY != itemB.cellY || itemA.id == itemB.id) {
+					continue;
+				}
+
+				const Proxy& proxyB = proxies_[itemB.id];
+				if ((proxyA.category & proxyB.mask) == 0 && (proxyB.category & proxyA.mask) == 0) {
+					continue;
+				}
+				if (!AABB::CheckCollision(proxyA.aabb, proxyB.aabb)) {
+					continue;
+				}
+
+				// 複数のセルにまたがる組は、重なった範囲の左下の角があるセルでだけ数える
+				const int32_t ownerX = CellCoord((std::max)(proxyA.aabb.min.x, proxyB.aabb.min.x));
+				const int32_t ownerY = CellCoord((std::max)(proxyA.aabb.min.y, proxyB.aabb.min.y));
+				if (ownerX != itemA.cellX || ownerY != itemA.cellY) {
+					continue;
+				}
+
+				pairs.push_back({(std::min)(itemA.id, itemB.id), (std::max)(itemA.id, itemB.id)});
+			}
+		}
+	}
+
+	// 処理順が登録順で決まるように並べる（総当たりのときと同じ順番になる）
+	std::sort(pairs.begin(), pairs.end(), [](const Pair& lhs, const Pair& rhs) { return lhs.a != rhs.a ? lhs.a < rhs.a : lhs.b < rhs.b; });
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "../struct.h"
+#include <KamataEngine.h>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+// キャラクター・アイテム同士の当たり判定の広域判定
+// XY平面を一定の大きさのセルで区切り、同じセルに入ったものの組だけを調べる（総当たりをしない）
+class SpatialHash {
+public:
+	using ProxyId = uint32_t;
+
+	// 当たっている組（a < b）
+	struct Pair {
+		ProxyId a;
+		ProxyId b;
+	};
+
+	explicit SpatialHash(float cellSize = 2.0f) : cellSize_(cellSize) {}
+
+	void SetCellSize(float cellSize) { cellSize_ = cellSize; }
+
+	// 登録をすべて消す（確保したメモリは次のフレームで使い回す）
+	void Clear();
+
+	// 箱を登録する。category は自分の種類、mask は相手にする種類（どちらかが相手を含めば組にする）
+	ProxyId Insert(const AABB& aabb, uint32_t category, uint32_t mask, uint32_t userData);
+
+	// 登録した箱をセルに振り分ける（FindPairs の前に1回呼ぶ）
+	void Build();
+
+	// 重なっている組を、ProxyId の小さい順（登録順）に重複なく集める
+	void FindPairs(std::vector<Pair>& pairs) const;
+
+	uint32_t GetCategory(ProxyId id) const { return proxies_[id].category; }
+	uint32_t GetUserData(ProxyId id) const { return proxies_[id].userData; }
+	size_t GetProxyCount() const { return proxies_.size(); }
+
+private:
+	struct Proxy {
+		AABB aabb;
+		uint32_t category;
+		uint32_t mask;
+		uint32_t userData;
+	};
+
+	// セルに入った箱（同じバケットに別のセルが混ざるので、セル座標も持つ）
+	struct CellItem {
+		ProxyId id;
+		int32_t cellX;
+		int32_t cellY;
+	};
+
+	// バケット数の下限（2のべき乗）
+	static inline const uint32_t kMinBucketCount = 64;
+
+	float cellSize_;
+
+	std::vector<Proxy> proxies_;
+
+	// バケットごとの CellItem（CSR：bucketOffsets_[b] から bucketOffsets_[b + 1] まで）
+	uint32_t bucketMask_ = 0;
+	std::vector<uint32_t> bucketOffsets_;
+	std::vector<CellItem> bucketItems_;
+	std::vector<uint32_t> bucketCursors_; // 詰めるときの書き込み位置
+
+	int32_t CellCoord(float v) const;
+	uint32_t BucketIndex(int32_t cellX, int32_t cellY) const;
+};
@@ -0,0 +1,218 @@
+#include "StageBinary.h"
+#include "MapChipField/MapChipField.h"
+#include <Windows.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+// spawnsOffset を 4byte 境界に揃える
+uint32_t AlignUp4(uint32_t value) { return (value + 3u) & ~3u; }
+} // namespace
+
+StageBinary::~StageBinary() { Close(); }
+
+bool StageBinary::Compile(const std::string& csvPath, const std::string& outputPath) {
+
+	// 既存のCSVローダーで読み込み、結果をそのままバイナリにする
+	MapChipField field;
+	if (!field.LoadMapChipCSV(csvPath)) {
+		return false;
+	}
+	return Write(outputPath, field);
+}
+
+bool StageBinary::CompileDirectory(const std::string& directory) {
+
+	std::error_code ec;
+	bool succeeded = true;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+		if (!entry.is_regular_file() || entry.path().extension() != ".csv") {
+			continue;
+		}
+		std::filesystem::path outputPath = entry.path();
+		outputPath.replace_extension(".stage");
+		// 1つ失敗しても残りは変換し、最後にまとめて失敗を返す
+		succeeded = Compile(entry.path().string(), outputPath.string()) && succeeded;
+	}
+	return succeeded && !ec;
+}
+
+bool StageBinary::Write(const std::string& outputPath, const MapChipField& field) {
+
+	const MapChipData& data = field.mapChipData_;
+
+	std::vector<StageSpawnIndex> enemies;
+	std::vector<StageSpawnIndex> coins;
+	std::vector<StageSpawnIndex> goals;
+	for (const auto& idx : field.GetEnemySpawnIndices()) {
+		enemies.push_back({idx.xIndex, idx.yIndex});
+	}
+	for (const auto& idx : field.GetCoinSpawnIndices()) {
+		coins.push_back({idx.xIndex, idx.yIndex});
+	}
+	for (const auto& idx : field.GetGoalSpawnIndices()) {
+		goals.push_back({idx.xIndex, idx.yIndex});
+	}
+
+	Contents contents;
+	contents.numBlockVirtical = data.numBlockVirtical;
+	contents.numBlockHorizontal = data.numBlockHorizontal;
+	contents.tiles = {reinterpret_cast<const uint8_t*>(data.data.data()), data.data.size()};
+	if (const auto& p = field.GetPlayerSpawnIndex()) {
+		contents.playerSpawn = StageSpawnIndex{p->xIndex, p->yIndex};
+	}
+	contents.enemySpawns = enemies;
+	contents.coinSpawns = coins;
+	contents.goalSpawns = goals;
+
+	return Write(outputPath, contents);
+}
+
+bool StageBinary::Write(const std::string& outputPath, const Contents& contents) {
+
+	const size_t numTiles = static_cast<size_t>(contents.numBlockVirtical) * contents.numBlockHorizontal;
+	if (contents.tiles.size() != numTiles) {
+		return false;
+	}
+
+	const uint32_t numSpawns = static_cast<uint32_t>(contents.enemySpawns.size() + contents.coinSpawns.size() + contents.goalSpawns.size());
+
+	Header header{};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.numBlockVirtical = contents.numBlockVirtical;
+	header.numBlockHorizontal = contents.numBlockHorizontal;
+	header.hasPlayerSpawn = contents.playerSpawn.has_value() ? 1u : 0u;
+	header.playerSpawn = contents.playerSpawn.value_or(StageSpawnIndex{0, 0});
+	header.numEnemySpawns = static_cast<uint32_t>(contents.enemySpawns.size());
+	header.numCoinSpawns = static_cast<uint32_t>(contents.coinSpawns.size());
+	header.numGoalSpawns = static_cast<uint32_t>(contents.goalSpawns.size());
+	header.tilesOffset = sizeof(Header);
+	header.spawnsOffset = AlignUp4(header.tilesOffset + static_cast<uint32_t>(numTiles));
+	header.fileSize = header.spawnsOffset + numSpawns * static_cast<uint32_t>(sizeof(StageSpawnIndex));
+
+	// ヘッダー以降をまとめて組み立ててからチェックサムを取る
+	std::vector<uint8_t> body(header.fileSize - sizeof(Header), 0);
+	std::memcpy(body.data(), contents.tiles.data(), numTiles);
+	uint8_t* spawns = body.data() + (header.spawnsOffset - sizeof(Header));
+	for (std::span<const StageSpawnIndex> list : {contents.enemySpawns, contents.coinSpawns, contents.goalSpawns}) {
+		if (!list.empty()) {
+			std::memcpy(spawns, list.data(), list.size_bytes());
+			spawns += list.size_bytes();
+		}
+	}
+	header.checksum = ComputeChecksum(body.data(), body.size());
+
+	std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	file.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+	return file.good();
+}
+
+bool StageBinary::Open(const std::string& filePath) {
+
+	Close();
+
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	file_ = file;
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+		Close();
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		Close();
+		return false;
+	}
+	mapping_ = mapping;
+
+	view_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+
+	if (view_ == nullptr || !Validate()) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void StageBinary::Close() {
+	if (view_) {
+		UnmapViewOfFile(view_);
+		view_ = nullptr;
+	}
+	if (mapping_) {
+		CloseHandle(static_cast<HANDLE>(mapping_));
+		mapping_ = nullptr;
+	}
+	if (file_) {
+		CloseHandle(static_cast<HANDLE>(file_));
+		file_ = nullptr;
+	}
+	size_ = 0;
+}
+
+std::span<const uint8_t> StageBinary::GetTiles() const {
+	const Header& header = GetHeader();
+	return {view_ + header.tilesOffset, static_cast<size_t>(header.numBlockVirtical) * header.numBlockHorizontal};
+}
+
+std::span<const StageSpawnIndex> StageBinary::GetEnemySpawns() const {
+	const Header& header = GetHeader();
+	return {reinterpret_cast<const StageSpawnIndex*>(view_ + header.spawnsOffset), header.numEnemySpawns};
+}
+
+std::span<const StageSpawnIndex> StageBinary::GetCoinSpawns() const {
+	const Header& header = GetHeader();
+	return {reinterpret_cast<const StageSpawnIndex*>(view_ + header.spawnsOffset) + header.numEnemySpawns, header.numCoinSpawns};
+}
+
+std::span<const StageSpawnIndex> StageBinary::GetGoalSpawns() const {
+	const Header& header = GetHeader();
+	return {reinterpret_cast<const StageSpawnIndex*>(view_ + header.spawnsOffset) + header.numEnemySpawns + header.numCoinSpawns, header.numGoalSpawns};
+}
+
+uint32_t StageBinary::ComputeChecksum(const uint8_t* data, size_t size) {
+	// FNV-1a (32bit)
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+bool StageBinary::Validate() const {
+
+	const Header& header = GetHeader();
+
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+		return false;
+	}
+	if (header.fileSize != size_) {
+		return false;
+	}
+
+	// 各領域がファイル内に収まっているか（64bitで計算して桁あふれを避ける）
+	const uint64_t numTiles = static_cast<uint64_t>(header.numBlockVirtical) * header.numBlockHorizontal;
+	const uint64_t numSpawns = static_cast<uint64_t>(header.numEnemySpawns) + header.numCoinSpawns + header.numGoalSpawns;
+	if (header.tilesOffset < sizeof(Header) || header.tilesOffset + numTiles > size_) {
+		return false;
+	}
+	if (header.spawnsOffset % alignof(StageSpawnIndex) != 0 || header.spawnsOffset + numSpawns * sizeof(StageSpawnIndex) > size_) {
+		return false;
+	}
+
+	return ComputeChecksum(view_ + sizeof(Header), size_ - sizeof(Header)) == header.checksum;
+}
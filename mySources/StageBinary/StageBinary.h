@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+class MapChipField;
+
+// ステージのスポーン位置（MapChipField::IndexSet と同じ並び）
+struct StageSpawnIndex {
+	uint32_t xIndex;
+	uint32_t yIndex;
+};
+
+/// CSVから事前に変換したステージバイナリ（*.stage）
+/// ファイルをメモリにマップし、タイルとスポーン一覧を解析なしでそのまま参照する
+class StageBinary {
+public:
+	static inline const char kMagic[4] = {'A', 'L', '4', 'S'};
+	static inline const uint32_t kVersion = 1;
+
+	// ファイル先頭のヘッダー（以降のデータはすべてこのヘッダーからのオフセットで指す）
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t numBlockVirtical;
+		uint32_t numBlockHorizontal;
+		uint32_t hasPlayerSpawn;
+		StageSpawnIndex playerSpawn;
+		uint32_t numEnemySpawns;
+		uint32_t numCoinSpawns;
+		uint32_t numGoalSpawns;
+		uint32_t tilesOffset;  // 行優先のタイル（1byte/タイル）
+		uint32_t spawnsOffset; // 敵 → コイン → ゴールの順に StageSpawnIndex が並ぶ
+		uint32_t fileSize;
+		uint32_t checksum; // ヘッダー以降の FNV-1a
+	};
+
+	// 書き出し用にまとめたステージの中身
+	struct Contents {
+		uint32_t numBlockVirtical = 0;
+		uint32_t numBlockHorizontal = 0;
+		std::span<const uint8_t> tiles;
+		std::optional<StageSpawnIndex> playerSpawn;
+		std::span<const StageSpawnIndex> enemySpawns;
+		std::span<const StageSpawnIndex> coinSpawns;
+		std::span<const StageSpawnIndex> goalSpawns;
+	};
+
+	StageBinary() = default;
+	~StageBinary();
+	StageBinary(const StageBinary&) = delete;
+	StageBinary& operator=(const StageBinary&) = delete;
+
+	// ステージCSVをバイナリに変換して書き出す（オーサリングはCSVのまま）
+	static bool Compile(const std::string& csvPath, const std::string& outputPath);
+	// フォルダ内のCSVをすべて変換する（ビルド後イベントから --compile-stages で呼ぶ）
+	static bool CompileDirectory(const std::string& directory);
+	// 読み込み済みのフィールドをそのままバイナリとして書き出す
+	static bool Write(const std::string& outputPath, const MapChipField& field);
+	// 中身をバイナリとして書き出す
+	static bool Write(const std::string& outputPath, const Contents& contents);
+
+	// ファイルをマップしてヘッダー・サイズ・チェックサムを検証する。失敗時は何もマップしない
+	bool Open(const std::string& filePath);
+	void Close();
+	bool IsOpen() const { return view_ != nullptr; }
+
+	const Header& GetHeader() const { return *reinterpret_cast<const Header*>(view_); }
+	std::span<const uint8_t> GetTiles() const;
+	std::span<const StageSpawnIndex> GetEnemySpawns() const;
+	std::span<const StageSpawnIndex> GetCoinSpawns() const;
+	std::span<const StageSpawnIndex> GetGoalSpawns() const;
+
+private:
+	// Windows のハンドル（Windows.h をヘッダーに持ち込まないため void* で保持）
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+	const uint8_t* view_ = nullptr;
+	size_t size_ = 0;
+
+	static uint32_t ComputeChecksum(const uint8_t* data, size_t size);
+	bool Validate() const;
+};
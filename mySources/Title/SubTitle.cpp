@@ -55,16 +55,10 @@ void SubTitle3D::Update() {
 		effectiveVisible_ = visible_;
 	}
 
-	// 行列更新
-	using namespace KamataEngine::MathUtility;
-	Matrix4x4 S = MakeScaleMatrix(scale_);
-	Matrix4x4 Rx = MakeRotateXMatrix(rotation_.x);
-	Matrix4x4 Ry = MakeRotateYMatrix(rotation_.y);
-	Matrix4x4 Rz = MakeRotateZMatrix(rotation_.z);
-	Matrix4x4 R = Rz * Ry * Rx;
-	Matrix4x4 T = MakeTranslateMatrix(world_.translation_);
-	world_.matWorld_ = S * R * T;
-	world_.TransferMatrix();
+	// 行列更新（点滅は表示/非表示だけなので、タイトルが動いていなければ送り直さない）
+	world_.scale_ = scale_;
+	world_.rotation_ = rotation_;
+	transformCache_.Update(world_);
 }
 
 void SubTitle3D::Draw() {
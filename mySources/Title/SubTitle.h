@@ -1,5 +1,6 @@
 #pragma once
 #include "Title/Title.h"
+#include "TransformCache/TransformCache.h"
 #include <KamataEngine.h>
 #include <algorithm>
 
@@ -33,6 +34,7 @@ private:
 	Model* model_ = nullptr;
 	Camera* camera_ = nullptr;
 	WorldTransform world_;
+	TransformCache transformCache_;
 
 	Title* attachTitle_ = nullptr;
 	Vector3 offset_{0.0f, -2.0f, 0.0f};
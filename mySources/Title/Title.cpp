@@ -35,17 +35,7 @@ void Title::Draw() {
 // =======================
 // アフィン変換行列の更新処理
 // =======================
-void Title::UpdateAffineTransformMatrix() {
-	Matrix4x4 scaleMat = MakeScaleMatrix(worldTransform_.scale_);
-	Matrix4x4 rotZMat = MakeRotateZMatrix(worldTransform_.rotation_.z);
-	Matrix4x4 rotYMat = MakeRotateYMatrix(worldTransform_.rotation_.y);
-	Matrix4x4 rotXMat = MakeRotateXMatrix(worldTransform_.rotation_.x);
-	Matrix4x4 rotMat = rotZMat * rotYMat * rotXMat;
-	Matrix4x4 transMat = MakeTranslateMatrix(worldTransform_.translation_);
-	worldTransform_.matWorld_ = scaleMat * rotMat * transMat;
-
-	worldTransform_.TransferMatrix();
-}
+void Title::UpdateAffineTransformMatrix() { transformCache_.Update(worldTransform_); }
 
 Vector3 Title::GetWorldPosition() {
 	Vector3 worldPos;
@@ -1,4 +1,5 @@
 #pragma once
+#include "../TransformCache/TransformCache.h"
 #include <KamataEngine.h>
 
 using namespace KamataEngine;
@@ -33,6 +34,7 @@ private:
 	Model* model_ = nullptr;
 	Camera* camera_ = nullptr;
 	WorldTransform worldTransform_;
+	TransformCache transformCache_;
 
 	// ==== アニメーション ====
 	Vector3 baseTranslation_{};    // 揺らす前の基準位置
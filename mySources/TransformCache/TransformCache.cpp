@@ -0,0 +1,40 @@
+#include "TransformCache.h"
+#include "FastMath/FastMath.h"
+
+static bool SameVector(const Vector3& a, const Vector3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+bool TransformCache::Update(WorldTransform& worldTransform) {
+
+	if (valid_ && SameVector(scale_, worldTransform.scale_) && SameVector(rotation_, worldTransform.rotation_) && SameVector(translation_, worldTransform.translation_)) {
+		return false;
+	}
+
+	worldTransform.matWorld_ = FastMath::ComposeTRS(worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
+	worldTransform.TransferMatrix();
+
+	scale_ = worldTransform.scale_;
+	rotation_ = worldTransform.rotation_;
+	translation_ = worldTransform.translation_;
+	valid_ = true;
+
+	CountUpdates(1, 1);
+	return true;
+}
+
+void TransformCache::ResetFrameStats() {
+	rebuiltMatrices_.store(0, std::memory_order_relaxed);
+	uploadedMatrices_.store(0, std::memory_order_relaxed);
+}
+
+TransformCache::FrameStats TransformCache::GetFrameStats() {
+	FrameStats stats;
+	stats.rebuiltMatrices = rebuiltMatrices_.load(std::memory_order_relaxed);
+	// 送るのは定数バッファのワールド行列1つ分
+	stats.uploadedBytes = static_cast<size_t>(uploadedMatrices_.load(std::memory_order_relaxed)) * sizeof(Matrix4x4);
+	return stats;
+}
+
+void TransformCache::CountUpdates(uint32_t rebuiltCount, uint32_t uploadCount) {
+	rebuiltMatrices_.fetch_add(rebuiltCount, std::memory_order_relaxed);
+	uploadedMatrices_.fetch_add(uploadCount, std::memory_order_relaxed);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <KamataEngine.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+using namespace KamataEngine;
+
+// WorldTransform の行列を、拡縮・回転・平行移動が変わったときだけ作り直して GPU に送る
+// 最後に送ったときの値を覚えておき、同じなら何もしない（毎フレーム呼んでも送るのは動いたものだけ）
+class TransformCache {
+public:
+	// 変わっていれば 拡縮 * 回転(Z * Y * X) * 平行移動 で作り直して送り、true を返す
+	bool Update(WorldTransform& worldTransform);
+
+	// 次の Update で必ず作り直す（WorldTransform を使い回すときなど）
+	void Invalidate() { valid_ = false; }
+
+	// ============================
+	// 計測（デバッグ表示用）
+	// ============================
+
+	struct FrameStats {
+		uint32_t rebuiltMatrices = 0; // 作り直した行列の数
+		size_t uploadedBytes = 0;     // GPU に送ったバイト数
+	};
+
+	// フレームの頭で呼ぶ
+	static void ResetFrameStats();
+	static FrameStats GetFrameStats();
+
+	// TransformCache を通さずに行列を作ったもの・送ったもの（EntityWorld など）を数に入れる
+	static void CountUpdates(uint32_t rebuiltCount, uint32_t uploadCount);
+
+private:
+	Vector3 scale_ = {};
+	Vector3 rotation_ = {};
+	Vector3 translation_ = {};
+	bool valid_ = false;
+
+	// 敵の並列更新からも呼ばれるので atomic
+	static inline std::atomic<uint32_t> rebuiltMatrices_ = 0;
+	static inline std::atomic<uint32_t> uploadedMatrices_ = 0;
+};
@@ -24,3 +24,5 @@ inline float easeInOutSine(float x) { return -(std::cos(std::numbers::pi_v<float
 
 // 線形補間関数
 inline float lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+inline Vector3 lerp(const Vector3& a, const Vector3& b, float t) { return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t}; }